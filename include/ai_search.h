@@ -0,0 +1,69 @@
+#ifndef AI_SEARCH_H
+#define AI_SEARCH_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include "sim.h"
+
+/* Lookahead AI for the single-player opponent, the alternative to the
+ * scripted one in fighter.c. Every few steps it copies the match, plays
+ * each candidate action (attacks, block, advance, retreat, jumps, slides)
+ * forward a few hundred milliseconds against the player holding their
+ * current buttons, scores where each ends up and goes with the best.
+ *
+ * The search is anytime. Each pass looks further ahead than the last (and
+ * the final one at pairs of actions), trying the previous pass's best
+ * first, and when the budget runs out the best action evaluated so far is
+ * the answer. A harder level only has a bigger budget.
+ *
+ * It decides outside the step and presses the opponent's buttons the way a
+ * player would (sim_opponent_by_input), so a search cut short by the wall
+ * clock cannot desync anything: its buttons are recorded as player 2's.
+ * Runs that must reproduce on their own (headless, --verify) budget by
+ * simulated steps only. */
+
+typedef enum
+{
+    AI_CLASSIC, /* the scripted AI, no search */
+    AI_EASY,
+    AI_NORMAL,
+    AI_HARD,
+    AI_LEVEL_COUNT
+} AiLevel;
+
+typedef struct
+{
+    Uint32 budget_us; /* wall clock per search */
+    Uint32 max_steps; /* simulated steps per search */
+} AiBudget;
+
+extern const AiBudget ai_budgets[AI_LEVEL_COUNT];
+
+typedef struct
+{
+    int self, foe;
+    AiLevel level;
+    bool use_clock; /* stop on budget_us as well as max_steps */
+    Uint8 action;   /* under way */
+    Uint16 action_tick;
+    Uint8 replan_in; /* steps until the next search */
+
+    /* Totals, for reports */
+    Uint32 searches;
+    Uint32 cut_short; /* searches that ran out before finishing every pass */
+    Uint64 steps;     /* simulated */
+    Uint64 time;      /* performance counter */
+    Uint64 slowest;
+} AiSearch;
+
+/* For the opponent of `sim`, which must already be under sim_opponent_by_input */
+void ai_search_init(AiSearch *ai, const SimState *sim, AiLevel level, bool use_clock);
+
+/* The opponent's buttons for the coming step */
+FighterInput ai_search_input(AiSearch *ai, const SimState *sim);
+
+const char *ai_level_name(AiLevel level);
+/* -1 if unknown */
+int ai_level_find(const char *name);
+
+#endif // AI_SEARCH_H
@@ -0,0 +1,16 @@
+#ifndef ALLOC_DEBUG_H
+#define ALLOC_DEBUG_H
+
+#include <stdbool.h>
+
+/* Heap call counter for catching allocations where there should be none
+ * (mid-match). Only live in builds with SMACK_ALLOC_DEBUG defined and
+ * malloc/calloc/realloc/free wrapped at link time (make check-alloc); it
+ * then counts every such call made from the game's own code, on any
+ * thread. Libraries' internal allocations are not seen. Elsewhere the
+ * count stays 0. */
+bool alloc_debug_enabled(void);
+/* Running total of heap calls; compare two readings */
+int alloc_debug_count(void);
+
+#endif // ALLOC_DEBUG_H
@@ -0,0 +1,30 @@
+#ifndef ASSET_CACHE_H
+#define ASSET_CACHE_H
+
+#include <SDL2/SDL.h>
+#include "sprite_sheet.h"
+
+/* Process-wide, reference-counted sprite sheet cache keyed by file path.
+ * Each sheet is read from disk and uploaded once; every fighter that asks
+ * for the same path gets the same handle. Sheets stay resident when their
+ * count drops to zero so a match restart costs no I/O; they are only freed
+ * by asset_cache_purge() or asset_cache_clear(). */
+SpriteSheet *asset_cache_acquire(SDL_Renderer *renderer, const char *path);
+void asset_cache_release(SpriteSheet *sheet);
+
+/* Hands an already built sheet (e.g. an atlas region) to the cache so later
+ * acquires of `path` return it. Fails if `path` is already cached. */
+bool asset_cache_insert(const char *path, SpriteSheet *sheet);
+bool asset_cache_contains(const char *path);
+
+/* Re-reads a cached sheet and swaps the new pixels into the existing
+ * SpriteSheet, so every holder sees them at once (dev-mode hot reload).
+ * False if `path` is not cached or fails to load; the old sheet stays. */
+bool asset_cache_reload(SDL_Renderer *renderer, const char *path);
+
+/* Frees sheets nobody holds any more */
+void asset_cache_purge(void);
+/* Frees everything; call before destroying the renderer */
+void asset_cache_clear(void);
+
+#endif // ASSET_CACHE_H
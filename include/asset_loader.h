@@ -0,0 +1,46 @@
+#ifndef ASSET_LOADER_H
+#define ASSET_LOADER_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+/* Background asset loading. One worker thread runs the queued decode jobs
+ * (file reads, image decoding, atlas packing, audio decoding) in FIFO
+ * order; the main thread calls asset_loader_pump() once a frame to upload
+ * the decoded pixels to the GPU in row bands until the time budget is
+ * spent, then hands each finished asset to its owner's callback. Owners
+ * only ever see their assets on the main thread. */
+
+/* Runs on the worker; delivers results with asset_loader_deliver*() */
+typedef void (*AssetDecodeFn)(void *user);
+/* Runs on the main thread with the texture (or the delivered pointer);
+ * the texture is NULL if the upload failed */
+typedef void (*AssetReadyFn)(void *user, void *asset);
+
+bool asset_loader_start(void);
+/* Lets the worker drain its queue, then finishes every pending upload, so
+ * each owner gets (and later frees) its asset and nothing leaks.
+ * Call before destroying the owners or the renderer. */
+void asset_loader_stop(SDL_Renderer *renderer);
+bool asset_loader_running(void);
+
+/* Only while running; callers fall back to loading synchronously otherwise */
+void asset_loader_queue(AssetDecodeFn decode, void *user);
+/* Decodes `path` (packed pixels or any SDL_image format) and uploads it as
+ * an RGBA texture; `ready` gets the SDL_Texture* */
+void asset_loader_queue_image(const char *path, AssetReadyFn ready, void *user);
+
+/* From a decode job: hand over a surface to upload (ownership passes to the
+ * loader), or any other decoded asset to pass to `ready` as-is */
+void asset_loader_deliver_surface(SDL_Surface *surface, AssetReadyFn ready, void *user);
+void asset_loader_deliver(void *asset, AssetReadyFn ready, void *user);
+
+/* Uploads and dispatches for at most ~budget_us (always makes progress) */
+void asset_loader_pump(SDL_Renderer *renderer, Uint32 budget_us);
+
+/* True when nothing is queued, decoding or waiting to upload */
+bool asset_loader_idle(void);
+/* 0..1, for a loading bar */
+float asset_loader_progress(void);
+
+#endif // ASSET_LOADER_H
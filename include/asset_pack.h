@@ -0,0 +1,68 @@
+#ifndef ASSET_PACK_H
+#define ASSET_PACK_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+/* One indexed file (built by `make pack`) holding every startup asset in a
+ * load-ready form, memory-mapped and read in place. Any asset missing from
+ * the pack - or every asset, when there is no pack - is read from its loose
+ * file instead, so the pack is purely an optimisation.
+ *
+ * Layout (little-endian): AssetPackHeader, then `entry_count` AssetPackEntry
+ * records sorted by path, then the data blobs, each 16-byte aligned. */
+#define ASSET_PACK_PATH "assets/smack.pak"
+#define ASSET_PACK_MAGIC 0x4B504D53 /* "SMPK" */
+#define ASSET_PACK_VERSION 1
+#define ASSET_PACK_NAME_MAX 96
+#define ASSET_PACK_ALIGN 16
+
+typedef enum
+{
+    PACK_ENTRY_RAW = 0,    /* original file bytes (PNG, MP3, TTF...) */
+    PACK_ENTRY_PIXELS = 1, /* SDL_PIXELFORMAT_RGBA32, colour key baked into alpha */
+    PACK_ENTRY_PCM = 2     /* decoded audio in the mixer's output format */
+} AssetPackKind;
+
+typedef struct
+{
+    Uint32 magic;
+    Uint32 version;
+    Uint32 entry_count;
+    Uint32 reserved;
+} AssetPackHeader;
+
+typedef struct
+{
+    char path[ASSET_PACK_NAME_MAX]; /* as passed to the loaders, NUL padded */
+    Uint32 kind;
+    Uint32 offset; /* from the start of the file */
+    Uint32 size;
+    Uint32 w, h;   /* PIXELS: size in pixels; PCM: frequency, channels */
+    Uint32 format; /* PIXELS: SDL pixel format; PCM: SDL audio format */
+    Uint32 reserved[2];
+} AssetPackEntry;
+
+/* Maps the pack; returns false (and leaves loose-file loading in place) if
+ * it is missing or malformed. */
+bool asset_pack_open(const char *path);
+void asset_pack_close(void);
+bool asset_pack_is_open(void);
+
+const AssetPackEntry *asset_pack_find(const char *path);
+const void *asset_pack_data(const AssetPackEntry *entry);
+
+/* Surface whose pixels point straight into the mapping (read-only: never
+ * lock or write it). NULL if `path` has no PIXELS entry. Free with
+ * SDL_FreeSurface; the mapping stays. */
+SDL_Surface *asset_pack_surface(const char *path);
+
+/* Read stream for any asset: the packed bytes when `path` is a RAW entry,
+ * otherwise the loose file. Close it (or pass freesrc=1) as usual. */
+SDL_RWops *asset_pack_rw(const char *path);
+
+/* Collects up to `max` PIXELS entries whose path is `dir`/<name>; returns
+ * how many. Pointers stay valid while the pack is open. */
+int asset_pack_list(const char *dir, const char **paths, int max);
+
+#endif // ASSET_PACK_H
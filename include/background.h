@@ -23,6 +23,7 @@ typedef struct
     SDL_Texture *hover_texture;
     bool is_hovered;
     bool is_pressed;
+    int pending_loads; // textures still being loaded in the background
 } Button;
 
 Background *create_background(SDL_Renderer *ren, const char *path,
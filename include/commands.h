@@ -0,0 +1,77 @@
+#ifndef COMMANDS_H
+#define COMMANDS_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+/* Motion commands: short sequences of button presses ("forward forward",
+ * "back forward attack") that trigger a move of their own. Directions are
+ * relative to the opponent. Each press must follow the previous one within
+ * the archetype's command window, several presses in one step count in
+ * symbol order, and a completed command starts over from scratch (so a
+ * command that begins another one hides it).
+ *
+ * All of an archetype's commands are compiled into one automaton (an
+ * Aho-Corasick DFA over press symbols), so recognizing costs one table
+ * lookup per press however many commands a fighter defines. */
+
+#define COMMAND_MAX 8       /* per archetype */
+#define COMMAND_MAX_STEPS 6 /* presses per command */
+#define COMMAND_MAX_STATES (COMMAND_MAX * COMMAND_MAX_STEPS + 1)
+
+/* What a press can be, in the order one step's presses are fed */
+typedef enum
+{
+    SYM_FORWARD,
+    SYM_BACK,
+    SYM_JUMP,
+    SYM_ATTACK,
+    SYM_DOWN_ATTACK,
+    SYM_BLOCK,
+    SYM_SLIDE,
+    SYM_COUNT
+} CommandSymbol;
+
+typedef enum
+{
+    ACTION_NONE,
+    ACTION_DASH, /* slide for as long as the direction stays held */
+    ACTION_ATTACK1,
+    ACTION_ATTACK2,
+    ACTION_ATTACK3, /* that attack, even on the move or out of chain order */
+    ACTION_COUNT
+} CommandAction;
+
+typedef struct
+{
+    Uint8 action; /* CommandAction */
+    Uint8 length;
+    Uint8 steps[COMMAND_MAX_STEPS]; /* CommandSymbol */
+} Command;
+
+typedef struct
+{
+    int state_count;
+    Uint8 next[COMMAND_MAX_STATES][SYM_COUNT];
+    Uint8 action[COMMAND_MAX_STATES]; /* completed on reaching the state */
+} CommandDfa;
+
+/* An empty list gives a DFA that never fires. When two commands end the
+ * same way the one declared first wins. */
+void command_dfa_build(CommandDfa *dfa, const Command *commands, int count);
+
+/* Moves `state` on one press; returns the action it completes, if any
+ * (and then `state` is back at the start) */
+static inline CommandAction command_dfa_feed(const CommandDfa *dfa, Uint8 *state, CommandSymbol symbol)
+{
+    Uint8 next = dfa->next[*state][symbol];
+    CommandAction action = (CommandAction)dfa->action[next];
+    *state = action != ACTION_NONE ? 0 : next;
+    return action;
+}
+
+/* -1 if unknown */
+int command_symbol_find(const char *name);
+int command_action_find(const char *name);
+
+#endif // COMMANDS_H
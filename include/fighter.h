@@ -0,0 +1,269 @@
+#ifndef FIGHTER_H
+#define FIGHTER_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include "game_clock.h"
+#include "sprite_sheet.h"
+#include "sim_rng.h"
+#include "commands.h"
+
+/* Every fighter on screen - keyboard players and the AI opponent alike -
+ * lives in one FighterStore. The per-step simulation data is kept as
+ * parallel arrays indexed by fighter id so the update pass walks a few
+ * contiguous arrays. The store is plain data (no pointers), so a copy of it
+ * is a complete snapshot; sprite sheets are shared per archetype and live
+ * outside it. What differs between fighters is data: an archetype (tuning
+ * and animation table) and a controller (where the inputs come from). */
+
+#define MAX_FIGHTERS 4
+#define FIGHTER_HEIGHT 258
+#define FIGHTER_GROUND_LEVEL 375
+
+typedef enum
+{
+    FIGHTER_IDLE,
+    FIGHTER_WALKING,
+    FIGHTER_JUMPING,
+    FIGHTER_ATTACKING,
+    FIGHTER_BLOCKING,
+    FIGHTER_DEATH,
+    FIGHTER_HURT,
+    FIGHTER_SLIDE,
+    FIGHTER_BLOCK_HURT,
+    FIGHTER_PRAY,
+    FIGHTER_DOWN_ATTACK,
+    FIGHTER_REPOSITIONING /* AI back-off */
+} FighterState;
+
+typedef enum
+{
+    FACING_RIGHT,
+    FACING_LEFT
+} FighterDirection;
+
+/* Animations an archetype provides; attacks 1-3 follow current_attack */
+typedef enum
+{
+    ANIM_IDLE,
+    ANIM_WALK,
+    ANIM_JUMP,
+    ANIM_ATTACK1,
+    ANIM_ATTACK2,
+    ANIM_ATTACK3,
+    ANIM_BLOCK,
+    ANIM_HURT,
+    ANIM_DEATH,
+    ANIM_SLIDE,
+    ANIM_BLOCK_HURT,
+    ANIM_PRAY,
+    ANIM_DOWN_ATTACK,
+    ANIM_REPOSITION,
+    ANIM_COUNT
+} AnimId;
+
+/* One step's worth of buttons, whatever produced them */
+typedef Uint8 FighterInput;
+#define INPUT_LEFT (1u << 0)
+#define INPUT_RIGHT (1u << 1)
+#define INPUT_JUMP (1u << 2)
+#define INPUT_ATTACK (1u << 3)
+#define INPUT_DOWN_ATTACK (1u << 4)
+#define INPUT_BLOCK (1u << 5)
+#define INPUT_SLIDE (1u << 6)
+
+/* FighterStore.flags bits */
+#define FIGHTER_ON_GROUND (1u << 0)
+#define FIGHTER_IS_ATTACKING (1u << 1)
+#define FIGHTER_IS_BLOCKING (1u << 2)
+#define FIGHTER_HIT_LANDED (1u << 3) /* this swing has connected (or been blocked) */
+#define FIGHTER_DASHING (1u << 4)    /* a dash command's slide, until the direction is let go */
+#define FIGHTER_FROZEN (1u << 5)     /* held in hitstop this step */
+
+/* How an animation ends */
+typedef enum
+{
+    ANIM_LOOP, /* wraps around */
+    ANIM_HOLD, /* stops on its last frame (attacks, death) */
+    ANIM_ONCE  /* plays once, then the fighter goes idle (pray) */
+} AnimLoop;
+
+#define FIGHTER_MAX_FRAMES 16
+#define FIGHTER_NAME_MAX 32
+#define FIGHTER_PATH_MAX 96
+
+typedef struct
+{
+    char path[FIGHTER_PATH_MAX];
+    int frame_count;
+    Uint32 frame_delay; /* ms per frame */
+    Uint8 loop;         /* AnimLoop */
+    Sint8 cancel_frame; /* attacks: from this frame on, a fresh attack press
+                           chains into the next attack; -1 = never */
+} AnimDef;
+
+/* Archetypes come from FIGHTER_DEFS_PATH. The game spawns the two it names
+ * here; any further definitions follow them and are found by name. */
+#define FIGHTER_DEFS_PATH "assets/fighters.txt"
+#define FIGHTER_MAX_ARCHETYPES 4
+
+typedef enum
+{
+    ARCHETYPE_PLAYER, /* "player" */
+    ARCHETYPE_ENEMY   /* "enemy" */
+} ArchetypeId;
+
+/* How an AI-controlled fighter fights. Optional ai_* keys in the
+ * definitions; anything left out keeps fighter_ai_defaults. */
+typedef struct
+{
+    float attack_range;       /* attacks when the target is this close */
+    float block_range;        /* blocks the target's attacks inside this */
+    float reposition_trigger; /* backs off when closer than this, */
+    float reposition_speed;   /* at this fraction of its walk speed */
+    Uint16 reposition_min_ms, reposition_max_ms;
+    Uint16 cooldown_min_ms, cooldown_max_ms; /* between two back-offs */
+} AiTuning;
+
+extern const AiTuning fighter_ai_defaults;
+
+/* Sets the setting the definitions call `key` ("ai_attack_range", ...);
+ * false if there is no such key or the value is out of range */
+bool fighter_ai_set(AiTuning *ai, const char *key, double value);
+/* false if a min is above its max */
+bool fighter_ai_valid(const AiTuning *ai);
+
+typedef struct
+{
+    char name[FIGHTER_NAME_MAX];
+    float speed;
+    float jump_force;
+    float gravity;
+    Uint32 attack_duration;     /* ms */
+    Uint32 block_hurt_duration; /* ms */
+    Uint32 hitstop_ms;          /* both fighters freeze when this one lands a hit */
+    Uint32 block_hitstop_ms;    /* ...or has one blocked */
+    AiTuning ai;
+    Uint32 command_window_ms; /* most time between two presses of a command */
+    CommandDfa commands;
+    AnimDef anims[ANIM_COUNT];
+} FighterArchetype;
+
+/* Filled by fighter_defs_load; constant while any fighter exists */
+extern FighterArchetype fighter_archetypes[FIGHTER_MAX_ARCHETYPES];
+extern int fighter_archetype_count;
+/* Of the text they were parsed from, 0 before any */
+extern Uint32 fighter_defs_hash;
+
+/* Parses the definitions into fighter_archetypes. On any error the
+ * previous definitions are kept and false is returned. */
+bool fighter_defs_load(const char *path);
+bool fighter_defs_loaded(void);
+/* -1 if unknown */
+int fighter_archetype_find(const char *name);
+int fighter_anim_find(const char *name);
+const char *fighter_anim_name(AnimId anim);
+
+typedef struct
+{
+    SDL_Scancode left, right, jump, attack, down_attack, block, slide;
+    SDL_Scancode slide_alt; /* SDL_SCANCODE_UNKNOWN if none */
+} FighterKeymap;
+
+extern const FighterKeymap keymap_p1; /* A/D, SPACE, W, F, S, ALT */
+extern const FighterKeymap keymap_p2; /* arrows, KP_ENTER, KP_0, KP_PLUS */
+
+typedef enum
+{
+    CONTROL_PLAYER, /* follows the step's FighterInput (keyboard, network, replay, bot) */
+    CONTROL_AI      /* chases and fights `target` */
+} ControllerKind;
+
+typedef struct
+{
+    Uint8 kind; /* ControllerKind */
+    Sint8 target;
+} FighterController;
+
+typedef struct
+{
+    int count;
+
+    /* Hot: read and written every simulation step */
+    float x[MAX_FIGHTERS], y[MAX_FIGHTERS];
+    float prev_x[MAX_FIGHTERS], prev_y[MAX_FIGHTERS]; /* at the start of the last step */
+    float velocity_x[MAX_FIGHTERS], velocity_y[MAX_FIGHTERS];
+    float frame_width[MAX_FIGHTERS]; /* of the current animation's frames */
+    Uint8 state[MAX_FIGHTERS];       /* FighterState */
+    Uint8 direction[MAX_FIGHTERS];   /* FighterDirection */
+    Uint8 flags[MAX_FIGHTERS];
+    Uint8 current_attack[MAX_FIGHTERS]; /* 0..2 combo step */
+    Uint8 anim[MAX_FIGHTERS];           /* AnimId */
+    Uint8 current_frame[MAX_FIGHTERS];
+    FighterInput input[MAX_FIGHTERS];   /* last input applied */
+    FighterInput latched[MAX_FIGHTERS]; /* press-once buttons still held */
+    Uint32 last_frame_time[MAX_FIGHTERS];
+    Uint32 attack_start_time[MAX_FIGHTERS];
+    Uint32 block_hurt_start_time[MAX_FIGHTERS];
+    Uint16 hitstop_ms[MAX_FIGHTERS];   /* game time left frozen */
+    Uint8 command_state[MAX_FIGHTERS]; /* in the archetype's command DFA */
+    Uint32 command_time[MAX_FIGHTERS]; /* of the last press fed to it */
+
+    /* AI back-off timing */
+    Uint32 reposition_start_time[MAX_FIGHTERS];
+    Uint32 last_reposition_time[MAX_FIGHTERS];
+    Uint32 reposition_duration[MAX_FIGHTERS];
+
+    /* Fixed at spawn */
+    Uint8 archetype[MAX_FIGHTERS]; /* ArchetypeId */
+    FighterController controller[MAX_FIGHTERS];
+    AiTuning ai[MAX_FIGHTERS]; /* the archetype's, unless the match overrides it */
+} FighterStore;
+
+/* Acquires every archetype's sprite sheets from the asset cache (sizes only
+ * with a NULL renderer, for headless runs), loading the fighter definitions
+ * and frame data first if they are not loaded yet. Fighters can only be
+ * spawned while these are held; calling it again is a no-op. */
+bool fighter_assets_acquire(SDL_Renderer *renderer);
+void fighter_assets_release(void);
+
+/* Dev-mode hot reload. fighter_defs_reload re-reads FIGHTER_DEFS_PATH (and
+ * the frame data, whose frame counts follow it), swapping in any sheets the
+ * definitions now name; on failure everything stays as it was.
+ * fighter_assets_refresh re-derives frame widths after a sheet changed.
+ * Both fix up the live fighters in `store` (may be NULL): frame widths, and
+ * frames past a shortened animation; a reload also re-applies AI tuning
+ * and restarts command recognition. */
+bool fighter_defs_reload(SDL_Renderer *renderer, FighterStore *store);
+void fighter_assets_refresh(FighterStore *store);
+
+/* The loaded definitions and frame data, hashed together: two peers must
+ * agree on it to play the same fighters */
+Uint32 fighter_data_hash(void);
+
+void fighter_store_init(FighterStore *store);
+
+/* Returns the new fighter's id, or -1 if the store is full or the
+ * archetype's sheets are not loaded */
+int fighter_spawn(FighterStore *store, ArchetypeId archetype, FighterController controller,
+                  float x, float y, Uint32 now);
+
+/* Runs every fighter's controller in id order (so an AI sees the inputs
+ * the fighters before it took this step). Player-controlled fighters take
+ * inputs[id]; the AI draws from `rng` only. */
+void fighter_store_control(FighterStore *store, const FighterInput inputs[MAX_FIGHTERS], SimRng *rng, Uint32 now);
+FighterInput fighter_read_keys(const FighterKeymap *keys, const Uint8 *keystate);
+
+/* Physics, timers and animation for all fighters */
+void fighter_store_update(FighterStore *store, const GameClock *clock);
+void fighter_store_render(SDL_Renderer *renderer, const FighterStore *store, float alpha);
+
+void fighter_set_state(FighterStore *store, int id, FighterState state, Uint32 now);
+
+/* A hit (or a blocked one) connecting: attacker and defender both freeze
+ * for the attacker's hitstop. A frozen fighter takes no input, does not
+ * move or animate, and its timers stand still; the longer of two
+ * overlapping freezes wins. */
+void fighter_impact(FighterStore *store, int attacker, int defender, bool blocked);
+
+#endif // FIGHTER_H
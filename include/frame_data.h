@@ -0,0 +1,65 @@
+#ifndef FRAME_DATA_H
+#define FRAME_DATA_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include "fighter.h"
+
+/* Hit and hurt boxes for every frame of every archetype's animations,
+ * loaded from FRAME_DATA_PATH into flat fixed-size tables. Boxes are in
+ * frame pixels with the fighter facing right; a fighter facing left uses
+ * them mirrored inside its frame. Each frame holds up to FRAME_BOX_LANES
+ * boxes of each kind as parallel float arrays, padded with empty boxes, so
+ * one attacker-defender test is always the same FRAME_BOX_LANES^2 pair
+ * checks with no branches - written so the compiler turns them into SIMD
+ * compares. */
+
+#define FRAME_DATA_PATH "assets/framedata.txt"
+#define FRAME_BOX_LANES 4
+
+/* Where an attack animation is: startup before its first frame with a hit
+ * box, active on frames with one, recovery after */
+typedef enum
+{
+    PHASE_NONE, /* animation has no hit boxes */
+    PHASE_STARTUP,
+    PHASE_ACTIVE,
+    PHASE_RECOVERY
+} FramePhase;
+
+typedef struct
+{
+    float x0[FRAME_BOX_LANES], y0[FRAME_BOX_LANES];
+    float x1[FRAME_BOX_LANES], y1[FRAME_BOX_LANES];
+} FrameBoxes;
+
+typedef struct
+{
+    FrameBoxes hurt;
+    FrameBoxes hit;
+    Uint8 hurt_count, hit_count;
+    Uint8 phase; /* FramePhase */
+} FrameData;
+
+/* Replaces the tables; on any error they are left as they were. Needs the
+ * fighter definitions (fighter_defs_load) for names and frame counts. */
+bool frame_data_load(const char *path);
+bool frame_data_loaded(void);
+/* Of the loaded file's text; 0 before any */
+Uint32 frame_data_hash(void);
+
+/* Clamped to the archetype's frame count */
+const FrameData *frame_data_get(ArchetypeId archetype, AnimId anim, int frame);
+FramePhase fighter_frame_phase(const FighterStore *store, int id);
+
+/* True when `attacker` is on an active frame and one of its hit boxes
+ * overlaps one of `defender`'s hurt boxes */
+bool frame_data_hits(const FighterStore *store, int attacker, int defender);
+/* The hit rule both fight modes use: frame_data_hits, for an attacker that
+ * is attacking (a down attack included) */
+bool frame_data_attack_hits(const FighterStore *store, int attacker, int defender);
+
+/* Debug view: hurt boxes in blue, hit boxes in red (only while active) */
+void frame_data_render_boxes(SDL_Renderer *renderer, const FighterStore *store);
+
+#endif // FRAME_DATA_H
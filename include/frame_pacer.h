@@ -0,0 +1,49 @@
+#ifndef FRAME_PACER_H
+#define FRAME_PACER_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+/* Frame pacing for when vsync does not hold the loop back (vsync off, or a
+ * target below the display's rate). frame_pacer_wait() goes just before
+ * the present and returns at the next deadline, one period after the last:
+ * it sleeps for all but the last millisecond or so, which SDL_Delay cannot
+ * be trusted with, and spins on the performance counter for the rest. The
+ * margin left for the spin grows when a sleep overshoots and shrinks back
+ * slowly, so a core only busy-waits for as long as the OS needs.
+ *
+ * Every frame's interval (pacer returns, so present to present) goes into
+ * a history whatever the target, vsync included, for the jitter report. */
+
+#define FRAME_PACER_HISTORY 240
+
+typedef struct
+{
+    Uint64 hz;          /* performance counter */
+    Uint64 period;      /* counter ticks per frame, 0 for no limit */
+    Uint64 deadline;    /* the next frame's */
+    Uint64 last_frame;  /* when the previous wait returned */
+    Uint64 spin_margin; /* how early to stop sleeping */
+    float intervals[FRAME_PACER_HISTORY]; /* ms, newest at pos - 1 */
+    int pos, count;
+} FramePacer;
+
+typedef struct
+{
+    float target_ms; /* 0 without a limit */
+    float mean_ms;
+    float jitter_ms; /* standard deviation of the interval */
+    float worst_ms;  /* furthest any interval fell from the target (or mean) */
+    int frames;      /* in the history */
+} FramePacerStats;
+
+/* `target_fps` 0 paces nothing and only measures */
+void frame_pacer_init(FramePacer *pacer, int target_fps);
+
+/* Blocks until the next frame is due. A frame that ran more than a period
+ * late starts the schedule over rather than hurrying the ones after it. */
+void frame_pacer_wait(FramePacer *pacer);
+
+void frame_pacer_stats(const FramePacer *pacer, FramePacerStats *stats);
+
+#endif // FRAME_PACER_H
@@ -0,0 +1,32 @@
+#ifndef GAME_CLOCK_H
+#define GAME_CLOCK_H
+
+#include <SDL2/SDL.h>
+
+/* Simulation time. Advanced once per fixed step and handed to every
+ * update function, so all attack/hurt/animation timers within a step see
+ * the same "now" and the simulation can run faster than real time.
+ *
+ * Game time can run slow (a KO in slow motion): each step still takes
+ * step_ms of real time, but covers only step_ms * scale of game time.
+ * It stays whole milliseconds, with the remainder carried to the next
+ * step, so a scaled clock is as deterministic as a plain one. */
+#define GAME_CLOCK_SCALE_ONE 256 /* scale for normal speed */
+
+typedef struct
+{
+    Uint32 now;         /* game ms since the clock was started */
+    Uint32 step_ms;     /* real length of one simulation step */
+    Uint32 tick;        /* number of steps taken */
+    Uint32 delta_ms;    /* game time the last step covered */
+    Uint16 scale;       /* game time per real time, in 1/GAME_CLOCK_SCALE_ONE */
+    Uint16 carry;       /* game time short of a whole ms, in the same units */
+    Uint32 scale_ticks; /* steps left before the scale returns to normal */
+} GameClock;
+
+void game_clock_init(GameClock *clock, Uint32 step_ms);
+void game_clock_advance(GameClock *clock);
+/* Runs the next `ticks` steps at `scale` */
+void game_clock_set_scale(GameClock *clock, Uint16 scale, Uint32 ticks);
+
+#endif // GAME_CLOCK_H
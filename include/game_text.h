@@ -4,13 +4,72 @@
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
 #include <stdbool.h>
+#include "frame_pacer.h"
+#include "profiler.h"
 
+// Size used for the HUD overlays
+#define HUD_TEXT_SIZE 20
+// Longest string a single layout holds; the rest is cut off
+#define TEXT_MAX_GLYPHS 64
+
+typedef enum {
+    TEXT_ALIGN_LEFT,
+    TEXT_ALIGN_CENTER,
+    TEXT_ALIGN_RIGHT
+} TextAlign;
+
+typedef struct {
+    SDL_FRect dst;         // relative to the layout's top-left
+    SDL_FPoint uv0, uv1;   // texture coordinates in the glyph atlas
+} TextQuad;
+
+// A string already turned into glyph quads. Keep one around for text that
+// does not change and drawing it is just a vertex fill into the sprite batch.
+typedef struct {
+    int atlas;             // glyph atlas (one per point size), -1 if none
+    int count;
+    float w, h;
+    TextQuad quads[TEXT_MAX_GLYPHS];
+} TextLayout;
+
+// Glyphs are rasterized once per point size into an atlas; nothing below
+// allocates per frame. The default size is rasterized here, other sizes
+// on first use.
 bool text_init(const char* font_path, int font_size);
 
+// Call before destroying the renderer (glyph atlases are textures)
 void text_quit(void);
 
+// size 0 = the size given to text_init. Returns false if the text was cut.
+bool text_layout(TextLayout* layout, const char* text, int size);
+// (x, y) is the anchor: horizontal per `align`, vertically centred
+void text_draw_layout(SDL_Renderer* renderer, const TextLayout* layout, int x, int y, SDL_Color color, TextAlign align);
+// One-off string: laid out into a scratch layout each call
+void text_draw(SDL_Renderer* renderer, const char* text, int x, int y, int size, SDL_Color color, TextAlign align);
+
 void render_game_over_screen_single(SDL_Renderer *renderer, int winner);
 
 void render_game_over_screen_multi(SDL_Renderer *renderer, int winner);
 
+// "Loading" text over a progress bar; progress is 0..1
+void render_loading_screen(SDL_Renderer *renderer, float progress);
+
+// Top-right frame rate readout
+void render_fps_counter(SDL_Renderer *renderer, float fps);
+
+// Under the frame rate: mean frame time (against the pacer's target), its
+// standard deviation and the worst miss, ms
+void render_frame_pacing(SDL_Renderer *renderer, const FramePacerStats *stats);
+
+// Centred status line while an online match is being set up
+void render_waiting_screen(SDL_Renderer *renderer, const char *message);
+
+// Under those: input delay, rollback depths (ms) and stalls
+void render_netplay_stats(SDL_Renderer *renderer, int input_delay_ms, int rollback_ms, int max_rollback_ms,
+                          Uint32 stalls);
+
+// Top-left panel: a bar per profiler zone (ms per frame) over a histogram
+// of recent frame times with p50/p99/max
+void render_profiler_overlay(SDL_Renderer *renderer, const ProfilerStats *stats, bool tracing);
+
 #endif // GAME_TEXT_H
\ No newline at end of file
@@ -0,0 +1,86 @@
+#ifndef HEADLESS_H
+#define HEADLESS_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include "net_link.h"
+#include "sim.h"
+#include "ai_search.h"
+
+/* Runs whole AI-vs-AI matches with no window, renderer or audio. Player 1
+ * (and player 2 in multiplayer) is driven by a bot that presses keys, so the
+ * normal input path is exercised; the single-player opponent uses the enemy
+ * AI (--ai picks the scripted one or a lookahead level, budgeted by
+ * simulated steps so every run plays the same). The simulation is stepped
+ * directly, as fast as the CPU allows; each match is seeded from the
+ * config seed plus its index. */
+typedef struct
+{
+    int matches;
+    unsigned int seed;
+    bool multiplayer;
+    Uint32 time_limit_ms; /* a match still running after this is a draw */
+    bool verify;          /* rewind each match to a snapshot and check the replay matches */
+
+    /* --netplay: both players as rollback peers over a simulated network */
+    bool netplay;
+    NetConditions net;
+    int input_delay;     /* ticks */
+    int rollback_window; /* ticks */
+
+    const char *record_path; /* save the last match as a replay */
+    const char *replay_path; /* instead of matches: re-run this replay flat out */
+    AiLevel ai;              /* single player */
+} HeadlessConfig;
+
+typedef struct
+{
+    int matches;
+    int p1_wins;
+    int p2_wins;
+    int draws;
+    Uint64 ticks;
+    double seconds;
+    double snapshot_us; /* --verify: one save+restore */
+
+    /* --netplay, summed over both peers */
+    Uint32 net_rollbacks;
+    Uint32 net_resimulated;
+    Uint32 net_max_rollback;
+    Uint32 net_stalls;
+    Uint32 net_sync_waits;
+    Uint64 net_checked; /* peer states compared with the reference */
+
+    size_t replay_bytes; /* --record: size of the file written */
+
+    /* --ai with a lookahead level */
+    Uint32 ai_searches;
+    Uint32 ai_cut_short;
+    Uint64 ai_steps;
+    double ai_us;         /* all searches */
+    double ai_slowest_us; /* one search */
+} HeadlessStats;
+
+bool run_headless(const HeadlessConfig *config, HeadlessStats *stats);
+
+/* One bot match, for tools that play many side by side (tools/balance.c) */
+typedef struct
+{
+    int winner; /* 1 or 2, 0 for a draw */
+    Uint32 ticks;
+    Uint32 damage[2][ANIM_COUNT]; /* dealt by each side, by the move it was in */
+} HeadlessMatch;
+
+/* Plays a match in `sim` with bots seeded from `seed` alone, so it plays out
+ * the same whatever ran before it. `enemy_ai` (may be NULL) retunes the
+ * single-player AI. Reads no mutable globals: any number of threads may
+ * call it at once while fighter_assets_acquire is held. False if the match
+ * could not start. */
+bool headless_play_match(SimState *sim, bool multiplayer, Uint32 seed, Uint32 time_limit_ms,
+                         const AiTuning *enemy_ai, HeadlessMatch *out);
+
+/* Command line front end shared by `SMACK! --headless ...` and the
+ * standalone headless build. Returns a process exit code. */
+int headless_main(int argc, char *argv[]);
+
+#endif // HEADLESS_H
@@ -0,0 +1,22 @@
+#ifndef HOT_RELOAD_H
+#define HOT_RELOAD_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include "fighter.h"
+
+/* Developer mode (--dev): watches a directory tree with inotify and reloads
+ * just the files that changed, in place - a cached sprite sheet, a sound
+ * effect or music track, the fighter definitions or the frame data - so the
+ * fighters on screen use the new sheet or timing from their next step.
+ * Only on Linux; elsewhere hot_reload_start reports that and fails. */
+
+bool hot_reload_start(const char *dir);
+void hot_reload_stop(void);
+
+/* Handles every change since the last call without blocking; `fighters`
+ * (NULL outside a match) gets its live state fixed up. Returns how many
+ * files were reloaded. */
+int hot_reload_poll(SDL_Renderer *renderer, FighterStore *fighters);
+
+#endif // HOT_RELOAD_H
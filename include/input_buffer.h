@@ -0,0 +1,52 @@
+#ifndef INPUT_BUFFER_H
+#define INPUT_BUFFER_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include "fighter.h"
+
+/* Keyboard input taken from events rather than one look at the key state
+ * per frame. One player's key presses and releases go into a ring with
+ * their SDL timestamps, and each simulation step takes the events up to
+ * its own end time, so the steps of one frame see the keys change in the
+ * order and at the time they did. SDL2 stamps key events in whole
+ * milliseconds (on the SDL_GetTicks clock); that is as fine as it goes,
+ * and well inside an 8 ms step.
+ *
+ * A key changes at most once per step: an event that would flip it back
+ * waits for the next step. A tap shorter than a frame therefore still
+ * holds the button for one step, and every press and release is an edge
+ * of its own (the step's input against the one before), which is what the
+ * fighter store's press-once latches key on. */
+
+#define INPUT_BUFFER_SIZE 64 /* power of two */
+
+typedef struct
+{
+    Uint32 time; /* SDL event timestamp, ms */
+    Uint8 key;   /* bit in InputBuffer.keys_down */
+    bool down;
+} InputEvent;
+
+typedef struct
+{
+    const FighterKeymap *keys;
+    InputEvent events[INPUT_BUFFER_SIZE];
+    Uint32 head, tail; /* free running; head - tail events queued */
+    Uint8 keys_down;   /* after every event taken so far */
+} InputBuffer;
+
+void input_buffer_init(InputBuffer *buffer, const FighterKeymap *keys);
+
+/* Queues `e` if it is a press or release of one of the keymap's keys (key
+ * repeats are ignored); returns whether it was */
+bool input_buffer_event(InputBuffer *buffer, const SDL_Event *e);
+
+/* Input for the step ending at `until` (ms, the SDL_GetTicks clock) */
+FighterInput input_buffer_step(InputBuffer *buffer, Uint32 until);
+
+/* Takes every queued event at once, for frames in which no step reads the
+ * buffer, so a backlog is not replayed as a burst of taps later */
+void input_buffer_flush(InputBuffer *buffer);
+
+#endif // INPUT_BUFFER_H
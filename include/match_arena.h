@@ -0,0 +1,29 @@
+#ifndef MATCH_ARENA_H
+#define MATCH_ARENA_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/* Bump allocator for everything one match owns (fighter store, fight
+ * state). Nothing is freed individually: a restart or a new match just
+ * resets the arena, so starting a fight never touches the heap and the
+ * per-frame path has nothing to free. The caller provides the memory. */
+#define MATCH_ARENA_SIZE (64 * 1024)
+#define MATCH_ARENA_ALIGN 16
+
+typedef struct
+{
+    Uint8 *base;
+    size_t size;
+    size_t used;
+    size_t high_water; /* most ever used, for sizing MATCH_ARENA_SIZE */
+} MatchArena;
+
+void match_arena_init(MatchArena *arena, void *memory, size_t size);
+/* Zeroed, MATCH_ARENA_ALIGN-aligned; NULL (and a message) when full */
+void *match_arena_alloc(MatchArena *arena, size_t size);
+/* Drops every allocation at once */
+void match_arena_reset(MatchArena *arena);
+
+#endif // MATCH_ARENA_H
@@ -3,8 +3,8 @@
 
 #include <SDL2/SDL.h>
 #include <stdbool.h>
-#include "player.h"
-#include "player2.h"
+#include "fighter.h"
+#include "game_clock.h"
 
 // Fight system constants
 #define MAX_HEALTH 100
@@ -27,8 +27,8 @@ typedef struct
 // Multi-fight system structure
 typedef struct
 {
-    Fighter *fighter1;
-    Fighter *fighter2;
+    Fighter fighter1;
+    Fighter fighter2;
     bool fight_over;
     int winner; // 0 = no winner yet, 1 = player1, 2 = player2
     bool restart_requested;
@@ -36,17 +36,14 @@ typedef struct
 } MultiFight;
 
 // Function declarations
-MultiFight *create_multi_fight(void);
-void destroy_multi_fight(MultiFight *fight);
-void update_multi_fight(MultiFight *fight, Player *player1, Player2 *player2, Uint32 delta_time);
-void handle_collision(MultiFight *fight, Player *player1, Player2 *player2);
-void handle_combat(MultiFight *fight, Player *player1, Player2 *player2);
-void apply_damage_to_player1(Fighter *fighter, Player *player, int damage);
-void apply_damage_to_player2(Fighter *fighter, Player2 *player, int damage);
-void update_fighter1_state(Fighter *fighter, Player *player);
-void update_fighter2_state(Fighter *fighter, Player2 *player);
-bool check_player1_attack_hit(Player *attacker, Player2 *defender);
-bool check_player2_attack_hit(Player2 *attacker, Player *defender);
+/* Full health, nobody down; plain data, so copying it is a snapshot */
+void multi_fight_init(MultiFight *fight);
+/* `p1` and `p2` are fighter ids in `fighters` */
+void update_multi_fight(MultiFight *fight, FighterStore *fighters, int p1, int p2, const GameClock *clock);
+void handle_collision(MultiFight *fight, FighterStore *fighters, int p1, int p2);
+void handle_combat(MultiFight *fight, FighterStore *fighters, int p1, int p2, Uint32 now);
+void apply_damage_to_fighter(Fighter *fighter, FighterStore *fighters, int id, int damage, Uint32 now);
+void update_fighter_state(Fighter *fighter, FighterStore *fighters, int id, Uint32 now);
 void render_health_bars(SDL_Renderer *renderer, MultiFight *fight);
 void handle_multi_fight_game_over_input(MultiFight *fight, const Uint8 *keystate);
 
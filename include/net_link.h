@@ -0,0 +1,76 @@
+#ifndef NET_LINK_H
+#define NET_LINK_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include "sim_rng.h"
+
+/* Unreliable datagram link between two netplay peers. The rollback session
+ * only sees send/recv, so the same code runs over UDP (net_udp.h), over an
+ * in-memory pipe inside one process, and through the bad-network simulator
+ * below wrapped around either. */
+#define NET_MAX_PACKET 96
+
+typedef struct
+{
+    /* false if the packet could not be handed on (it is then lost) */
+    bool (*send)(void *ctx, const Uint8 *data, int len);
+    /* Copies one waiting packet into `data` and returns its length; 0 if none */
+    int (*recv)(void *ctx, Uint8 *data, int cap);
+    void *ctx;
+} NetLink;
+
+/* ---------- In-memory pipe ---------- */
+
+#define NET_PIPE_SLOTS 32
+
+/* One direction; a full pipe drops what is sent to it */
+typedef struct
+{
+    int head, count;
+    int len[NET_PIPE_SLOTS];
+    Uint8 data[NET_PIPE_SLOTS][NET_MAX_PACKET];
+} NetPipe;
+
+/* One peer's end: sends into `out`, receives from `in` */
+typedef struct
+{
+    NetPipe *out, *in;
+} NetPipeEnd;
+
+void net_pipe_init(NetPipe *pipe);
+NetLink net_pipe_link(NetPipeEnd *end);
+
+/* ---------- Bad-network simulator ---------- */
+
+#define NET_SIM_QUEUE 64
+
+typedef struct
+{
+    Uint32 latency_ms; /* one way, added to every packet sent */
+    Uint32 jitter_ms;  /* plus up to this much more, so packets can reorder */
+    int loss_percent;  /* chance each packet is silently dropped */
+} NetConditions;
+
+/* Holds outgoing packets until they are due, then passes them to `inner`.
+ * Time is whatever the owner sets in `now` (real or simulated ms); the
+ * drops and jitter come from a seeded generator, so a run repeats. */
+typedef struct
+{
+    NetLink inner;
+    NetConditions conditions;
+    SimRng rng;
+    Uint32 now;
+    int count;
+    Uint32 due[NET_SIM_QUEUE];
+    int len[NET_SIM_QUEUE];
+    Uint8 data[NET_SIM_QUEUE][NET_MAX_PACKET];
+} NetLinkSim;
+
+void net_link_sim_init(NetLinkSim *sim, NetLink inner, NetConditions conditions, Uint32 seed);
+/* Sends whatever has come due by `now` */
+void net_link_sim_pump(NetLinkSim *sim, Uint32 now);
+/* A link that sends through the simulator and receives straight from `inner` */
+NetLink net_link_sim_link(NetLinkSim *sim);
+
+#endif // NET_LINK_H
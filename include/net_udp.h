@@ -0,0 +1,25 @@
+#ifndef NET_UDP_H
+#define NET_UDP_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_net.h>
+#include <stdbool.h>
+#include "net_link.h"
+
+/* A NetLink over one UDP socket (SDL_net). The host binds a known port and
+ * takes the address of the first peer that writes to it; the joining side
+ * binds any port and talks to the address it was given. Non-blocking. */
+typedef struct
+{
+    UDPsocket socket;
+    UDPpacket *packet; /* allocated once, reused for every send and receive */
+    IPaddress peer;
+    bool has_peer;
+} NetUdp;
+
+/* peer_host NULL = host on `port`; otherwise join peer_host:port */
+bool net_udp_open(NetUdp *udp, const char *peer_host, Uint16 port);
+void net_udp_close(NetUdp *udp);
+NetLink net_udp_link(NetUdp *udp);
+
+#endif // NET_UDP_H
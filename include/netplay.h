@@ -0,0 +1,109 @@
+#ifndef NETPLAY_H
+#define NETPLAY_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include "sim.h"
+#include "net_link.h"
+
+/* Rollback netplay for the versus mode. Each peer runs the whole
+ * simulation: its own inputs are applied `input_delay` ticks after they are
+ * read, the other side's are predicted (held from the last one received)
+ * until they arrive. When a real input differs from the prediction the
+ * session restores the snapshot taken before that tick and re-simulates up
+ * to the present, so a late packet costs a correction instead of a stall.
+ * A peer only stalls when the other side's inputs are more than
+ * `rollback_window` ticks overdue.
+ *
+ * Every input packet carries all inputs the other side has not
+ * acknowledged yet, so a lost packet is covered by the next one. It also
+ * carries a checksum of a confirmed state, so a desync is reported instead
+ * of silently diverging. The whole session is plain data with fixed-size
+ * rings and can live in the match arena. */
+
+#define NETPLAY_DEFAULT_INPUT_DELAY 2  /* ticks: 16 ms, under one 60 Hz frame */
+#define NETPLAY_DEFAULT_ROLLBACK 12    /* ticks: 96 ms of lateness hidden */
+#define NETPLAY_MAX_INPUT_DELAY 8
+#define NETPLAY_MAX_ROLLBACK 32        /* snapshots kept */
+#define NETPLAY_INPUT_RING 128         /* ticks of input history, both sides */
+
+typedef struct
+{
+    Uint32 rollbacks;      /* corrections */
+    Uint32 resimulated;    /* ticks re-run by them */
+    Uint32 last_rollback;  /* depth of the latest, in ticks */
+    Uint32 max_rollback;
+    Uint32 stalls;         /* steps spent waiting on overdue inputs */
+    Uint32 sync_waits;     /* steps given up to let a lagging peer catch up */
+    Uint32 packets_sent;
+    Uint32 packets_received;
+} NetplayStats;
+
+typedef struct
+{
+    NetLink link;
+    int local_side; /* 0 = player 1 (the host), 1 = player 2 */
+    Uint32 seed;
+    int input_delay;
+    int rollback_window;
+
+    Uint32 tick;         /* ticks simulated (sim.clock.tick) */
+    Uint32 local_next;   /* next tick a local input is stamped for: tick + delay */
+    Uint32 remote_next;  /* remote inputs known for every tick below this */
+    Uint32 remote_ack;   /* the remote has our inputs below this */
+    Uint32 remote_tick;  /* its tick as of its latest packet */
+    Sint8 remote_advantage;
+    Uint32 last_sync_tick;
+    Uint32 first_wrong;  /* earliest mispredicted tick, UINT32_MAX if none */
+    bool desynced;
+
+    FighterInput inputs[NETPLAY_INPUT_RING][2]; /* by tick, by side */
+    FighterInput used[NETPLAY_INPUT_RING];      /* remote input each simulated tick ran with */
+
+    SimState sim;                                  /* present, possibly predicted */
+    SimState snapshots[NETPLAY_MAX_ROLLBACK];      /* state before tick t, at t % N */
+    NetplayStats stats;
+} NetplaySession;
+
+/* Both peers must pass the same seed and input delay (the handshake below
+ * settles them). False if the match could not be set up. */
+bool netplay_start(NetplaySession *session, NetLink link, int local_side, Uint32 seed,
+                   int input_delay, int rollback_window);
+
+/* One fixed step: takes in packets, rolls back if a prediction was wrong,
+ * then (unless stalled) stamps `local` and simulates one tick, and sends.
+ * Returns false if the simulation did not advance this step. */
+bool netplay_step(NetplaySession *session, FighterInput local);
+
+/* Inputs from both sides are known for every tick below this */
+Uint32 netplay_confirmed_tick(const NetplaySession *session);
+/* The final state before `tick`, or NULL if it is not confirmed yet or no
+ * longer kept */
+const SimState *netplay_state_at(const NetplaySession *session, Uint32 tick);
+/* The confirmed inputs of `tick` (below netplay_confirmed_tick and still
+ * in the ring), laid out for sim_step */
+void netplay_tick_inputs(const NetplaySession *session, Uint32 tick, FighterInput inputs[MAX_FIGHTERS]);
+
+/* ---------- Handshake ---------- */
+
+/* The host (player 1) waits for a hello and answers with the seed and
+ * input delay; the joining side repeats its hello until that arrives.
+ * Both carry fighter_data_hash(), and a side that sees the other's differ
+ * refuses to start. */
+typedef struct
+{
+    NetLink link;
+    bool host;
+    Uint32 seed;
+    int input_delay;
+    Uint32 last_hello;
+    bool hello_sent;
+    bool refused; /* the definitions differ */
+} NetplayHandshake;
+
+void netplay_handshake_init(NetplayHandshake *handshake, NetLink link, bool host, Uint32 seed, int input_delay);
+/* True once both sides agree; seed and input_delay are then final. Stays
+ * false once refused. */
+bool netplay_handshake_poll(NetplayHandshake *handshake, Uint32 now);
+
+#endif // NETPLAY_H
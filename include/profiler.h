@@ -0,0 +1,92 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+/* Frame profiler. A zone is a begin/end pair around a piece of work, timed
+ * with the performance counter:
+ *
+ *     ProfScope scope = prof_begin(PROF_SOUND);
+ *     sound_play_effects(...);
+ *     prof_end(scope);
+ *
+ * prof_end() pushes the sample into a fixed lock-free ring that any thread
+ * may write to; once per frame profiler_frame() drains it on the main
+ * thread into per-zone totals and a frame-time history. Nothing allocates.
+ * With the profiler off (headless runs) a zone costs one branch. */
+
+typedef enum
+{
+    PROF_EVENTS,
+    PROF_LOADER,     /* asset_loader_pump: uploads on the main thread */
+    PROF_NET,
+    PROF_SIM,        /* all fixed steps this frame; the next four nest in it */
+    PROF_AI,         /* fighter controllers */
+    PROF_FIGHTERS,   /* fighter physics and animation */
+    PROF_FIGHT,      /* hits, health, round end */
+    PROF_SEARCH,     /* lookahead AI, deciding before the step */
+    PROF_BACKGROUND, /* update and render */
+    PROF_RENDER_FIGHTERS,
+    PROF_HUD,
+    PROF_SOUND,
+    PROF_PRESENT,
+    PROF_PACE,   /* waiting for the frame pacer's deadline */
+    PROF_DECODE, /* asset loader thread */
+    PROF_ZONE_COUNT
+} ProfZone;
+
+typedef struct
+{
+    Uint64 start; /* 0 when the profiler is off */
+    ProfZone zone;
+} ProfScope;
+
+/* Frames kept for the overlay: averages use the newest PROF_AVERAGE_FRAMES,
+ * the histogram and percentiles all of them */
+#define PROF_HISTORY 256
+#define PROF_AVERAGE_FRAMES 30
+#define PROF_HISTOGRAM_BINS 34 /* 1 ms each; the last also holds anything slower */
+
+typedef struct
+{
+    float zone_ms[PROF_ZONE_COUNT]; /* per frame */
+    float frame_p50, frame_p99, frame_max;
+    int histogram[PROF_HISTOGRAM_BINS];
+    int frames;    /* in the history so far */
+    Uint32 dropped; /* samples the ring overran */
+} ProfilerStats;
+
+extern bool profiler_active;
+
+/* Call once, before any thread records a zone */
+void profiler_init(bool enabled);
+/* Where `enabled` was false this does nothing */
+void profiler_record(ProfZone zone, Uint64 start, Uint64 end);
+
+static inline ProfScope prof_begin(ProfZone zone)
+{
+    ProfScope scope = {profiler_active ? SDL_GetPerformanceCounter() : 0, zone};
+    return scope;
+}
+
+static inline void prof_end(ProfScope scope)
+{
+    if (scope.start)
+        profiler_record(scope.zone, scope.start, SDL_GetPerformanceCounter());
+}
+
+/* Closes the frame started by the previous call */
+void profiler_frame(void);
+void profiler_stats(ProfilerStats *stats);
+const char *profiler_zone_name(ProfZone zone);
+/* 1 for zones nested inside another */
+int profiler_zone_depth(ProfZone zone);
+
+/* Chrome trace-event JSON (chrome://tracing, Perfetto): every zone recorded
+ * from start to stop goes to the file as it is drained */
+bool profiler_trace_start(const char *path);
+void profiler_trace_stop(void);
+bool profiler_tracing(void);
+
+#endif // PROFILER_H
@@ -0,0 +1,76 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include "sim.h"
+
+/* A match as a seed plus both players' inputs for every tick - everything
+ * sim_step needs to play it again bit for bit. Each tick's two inputs
+ * (7 bits each) are packed into one 14-bit word, and runs of identical
+ * ticks are stored once with a varint count, so a 99 s match is a few KB.
+ * Recording writes into a fixed buffer, never the heap; if a match outgrows
+ * it the replay is cut short and flagged.
+ *
+ * File layout, little-endian on any host: ReplayHeader's fields as Uint32s
+ * in declaration order, then `data_size` bytes of runs, each a 2-byte input
+ * word and a LEB128 tick count. */
+#define REPLAY_MAGIC 0x50524D53 /* "SMRP" */
+#define REPLAY_VERSION 1
+#define REPLAY_MAX_DATA (64 * 1024)
+#define REPLAY_DIR "replays/"
+
+/* ReplayHeader.flags */
+#define REPLAY_MULTIPLAYER (1u << 0)
+#define REPLAY_HAS_CHECKSUM (1u << 1) /* final_checksum is the state after the last tick */
+#define REPLAY_TRUNCATED (1u << 2)    /* ran out of space before the match ended */
+#define REPLAY_OPPONENT_INPUT (1u << 3) /* single player: the opponent's inputs are recorded too */
+
+typedef struct
+{
+    Uint32 magic;
+    Uint32 version;
+    Uint32 flags;
+    Uint32 seed;
+    Uint32 step_ms;
+    Uint32 ticks;
+    Uint32 final_checksum; /* sim_checksum; only comparable within one build */
+    Uint32 data_size;
+} ReplayHeader;
+
+typedef struct
+{
+    ReplayHeader header;
+    Uint16 run_input; /* the run still being counted */
+    Uint32 run_length;
+    Uint8 data[REPLAY_MAX_DATA];
+} Replay;
+
+void replay_begin(Replay *replay, Uint32 seed, bool multiplayer, Uint32 step_ms);
+/* One tick: player 1's and player 2's inputs (0 for the scripted AI) */
+void replay_record(Replay *replay, FighterInput p1, FighterInput p2);
+/* Closes the last run; `final` is the state after the last recorded tick,
+ * or NULL if it is not known */
+void replay_end(Replay *replay, const SimState *final);
+
+bool replay_save(const Replay *replay, const char *path);
+bool replay_load(Replay *replay, const char *path);
+
+/* Walks a finished replay tick by tick */
+typedef struct
+{
+    const Replay *replay;
+    Uint32 offset;
+    Uint16 input;
+    Uint32 remaining; /* ticks left in the current run */
+    Uint32 tick;
+} ReplayCursor;
+
+void replay_cursor_init(ReplayCursor *cursor, const Replay *replay);
+/* False once every recorded tick has been read (or the data is bad) */
+bool replay_cursor_next(ReplayCursor *cursor, FighterInput *p1, FighterInput *p2);
+
+/* Starts `sim` as the recorded match began */
+bool replay_start_sim(const Replay *replay, SimState *sim);
+
+#endif // REPLAY_H
@@ -0,0 +1,65 @@
+#ifndef SIM_H
+#define SIM_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include "game_clock.h"
+#include "sim_rng.h"
+#include "fighter.h"
+#include "singlefight.h"
+#include "multifight.h"
+
+/* Fixed simulation step: the fight always advances in SIM_STEP_MS slices no
+ * matter how long a frame took. 8 ms = 125 Hz, kept integral so the
+ * millisecond timers stay exact. */
+#define SIM_STEP_MS 8
+
+/* One match's complete simulation state. Plain data: no pointers, no
+ * hidden statics, randomness from its own seeded generator. Everything
+ * the step reads from outside comes in through the per-step inputs, so the
+ * same seed and the same input sequence produce bit-identical states, and
+ * a memcpy of the struct is a full snapshot that can be restored later. */
+typedef struct
+{
+    GameClock clock;
+    SimRng rng;
+    bool multiplayer;
+    int p1, p2; /* fighter ids; p2 is player 2 or the AI opponent */
+    FighterStore fighters;
+    SingleFight single; /* used when !multiplayer */
+    MultiFight multi;   /* used when multiplayer */
+} SimState;
+
+/* Fresh match at time 0. The fighters' sheets must be held
+ * (fighter_assets_acquire); false if the fighters could not be spawned. */
+bool sim_start(SimState *sim, bool multiplayer, Uint32 seed, Uint32 step_ms);
+
+/* Advances one fixed step. inputs[id] drives player-controlled fighters;
+ * entries for AI fighters are ignored. Once the fight is over the fighters
+ * keep animating but take no input. */
+void sim_step(SimState *sim, const FighterInput inputs[MAX_FIGHTERS]);
+/* The same step for a search looking ahead on a copy: hundreds of these
+ * run per tick, so they are kept out of the profiler */
+void sim_lookahead_step(SimState *sim, const FighterInput inputs[MAX_FIGHTERS]);
+
+/* Single player: the opponent stops running its scripted AI in the step and
+ * follows inputs[p2] instead, for a controller that decides outside the
+ * simulation (the lookahead AI). Those inputs are then part of the match
+ * like a player's. Call right after sim_start. */
+void sim_opponent_by_input(SimState *sim);
+/* Whether inputs[id] drives fighter `id` (and so belongs in a replay) */
+bool sim_takes_input(const SimState *sim, int id);
+
+bool sim_fight_over(const SimState *sim);
+/* 0 = none yet, 1 = player 1, 2 = player 2 / the AI */
+int sim_winner(const SimState *sim);
+/* 0 = player 1, 1 = player 2 / the AI */
+int sim_health(const SimState *sim, int side);
+
+void sim_save(const SimState *sim, SimState *snapshot);
+void sim_restore(SimState *sim, const SimState *snapshot);
+
+/* FNV-1a over the state's bytes, for comparing two runs or two peers */
+Uint32 sim_checksum(const SimState *sim);
+
+#endif // SIM_H
@@ -0,0 +1,19 @@
+#ifndef SIM_RNG_H
+#define SIM_RNG_H
+
+#include <SDL2/SDL.h>
+
+/* The simulation's only source of randomness. Seeded per match and stored
+ * in the simulation state, so a snapshot captures it and the same seed plus
+ * the same inputs replays the same fight. */
+typedef struct
+{
+    Uint32 state;
+} SimRng;
+
+void sim_rng_seed(SimRng *rng, Uint32 seed);
+Uint32 sim_rng_next(SimRng *rng);
+/* Uniform-ish in [lo, hi] */
+Uint32 sim_rng_range(SimRng *rng, Uint32 lo, Uint32 hi);
+
+#endif // SIM_RNG_H
@@ -3,13 +3,13 @@
 
 #include <SDL2/SDL.h>
 #include <stdbool.h>
-#include "player.h"
-#include "enemy.h"
+#include "fighter.h"
+#include "game_clock.h"
 
 // Fight system constants
 #define MAX_HEALTH 100
 #define ATTACK_DAMAGE 5
-#define HURT_ANIMATION_DURATION 300   // milliseconds
+#define SINGLE_HURT_ANIMATION_DURATION 300 // milliseconds (multifight.h uses 500)
 #define DEATH_ANIMATION_DURATION 500 // milliseconds
 #define PLAYER_COLLISION_OFFSET 50    // pixels between players when colliding
 
@@ -27,8 +27,8 @@ typedef struct
 // Single-fight system structure
 typedef struct
 {
-    Warrior *fighter1;
-    Warrior *fighter2;
+    Warrior fighter1;
+    Warrior fighter2;
     bool fight_over;
     int winner; // 0 = no winner yet, 1 = player1, 2 = enemy
     bool restart_requested;
@@ -36,17 +36,15 @@ typedef struct
 } SingleFight;
 
 // Function declarations
-SingleFight *create_single_fight(void);
-void destroy_single_fight(SingleFight *fight);
-void update_single_fight(SingleFight *fight, Player *player1, Enemy *enemy, Uint32 delta_time);
-void collision(SingleFight *fight, Player *player1, Enemy *enemy);
-void combat(SingleFight *fight, Player *player1, Enemy *enemy);
-void damage_to_player1(Warrior *fighter, Player *player, int damage);
-void apply_damage_to_enemy(Warrior *fighter, Enemy *player, int damage);
-void fighter1_state(Warrior *fighter, Player *player, Uint32 delta_time);
-void update_enemy_state(Warrior *fighter, Enemy *player, Uint32 delta_time);
-bool player1_attack_hit(Player *attacker, Enemy *defender);
-bool check_enemy_attack_hit(Enemy *attacker, Player *defender);
+/* Full health, nobody down; plain data, so copying it is a snapshot */
+void single_fight_init(SingleFight *fight);
+/* `player` and `enemy` are fighter ids in `fighters` */
+void update_single_fight(SingleFight *fight, FighterStore *fighters, int player, int enemy, const GameClock *clock);
+void collision(SingleFight *fight, FighterStore *fighters, int player, int enemy);
+void combat(SingleFight *fight, FighterStore *fighters, int player, int enemy, Uint32 now);
+void apply_damage_to_warrior(Warrior *fighter, FighterStore *fighters, int id, int damage, Uint32 now);
+void fighter1_state(Warrior *fighter, FighterStore *fighters, int player, Uint32 now);
+void update_enemy_state(Warrior *fighter, FighterStore *fighters, int enemy, Uint32 now);
 void health_bars(SDL_Renderer *renderer, SingleFight *fight);
 void handle_single_fight_game_over_input(SingleFight *fight, const Uint8 *keystate);
 
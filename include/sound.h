@@ -3,16 +3,23 @@
 
 #include <SDL2/SDL_mixer.h>
 #include <stdbool.h>
-#include "player.h" // For player states
-#include "player2.h" // For player2 states
-#include "enemy.h"   // For enemy states
+#include "fighter.h" // For fighter states
 
+// Mixer output format; the asset packer decodes effects to exactly this
+#define SOUND_FREQUENCY 44100
+#define SOUND_FORMAT MIX_DEFAULT_FORMAT
+#define SOUND_CHANNELS 2
+#define SOUND_CHUNK_SIZE 2048
 
 void sound_init(void);
 
 void sound_play_music(const char* map_name);
 
-void sound_play_effects(Player *p1, Player2 *p2, Enemy *enemy);
+void sound_play_effects(const FighterStore *fighters);
+
+// Dev-mode hot reload: reloads the effect or music track loaded from `path`
+// in place. False if no sound comes from that file.
+bool sound_reload(const char* path);
 
 void sound_stop_all(void);
 
@@ -0,0 +1,36 @@
+#ifndef SPRITE_BATCH_H
+#define SPRITE_BATCH_H
+
+#include <SDL2/SDL.h>
+
+/* Everything the game draws - sprites, glyphs and solid rectangles - goes
+ * through here as quads. Consecutive quads that use the same texture (or
+ * none, for solid fills) are collected into one fixed vertex buffer and
+ * drawn with a single SDL_RenderGeometry call when the texture changes, the
+ * buffer fills or the frame ends. Draw order is kept, so the number of draw
+ * calls follows the number of texture switches, not the number of quads;
+ * fighters sharing an atlas page and a screen of HUD text cost one each.
+ *
+ * Anything drawn with the SDL_Render* calls directly must flush first. */
+
+#define SPRITE_BATCH_MAX_QUADS 512
+
+/* `src` in texel coordinates (NULL = the whole texture) */
+void sprite_batch_sprite(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect *src, const SDL_FRect *dst,
+                         SDL_RendererFlip flip, SDL_Color tint);
+/* Texture coordinates already normalised (glyph quads) */
+void sprite_batch_quad(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_FRect *dst, SDL_FPoint uv0,
+                       SDL_FPoint uv1, SDL_Color tint);
+/* Solid colour, alpha blended */
+void sprite_batch_fill(SDL_Renderer *renderer, const SDL_FRect *rect, SDL_Color color);
+/* One pixel border just inside `rect`, like SDL_RenderDrawRect */
+void sprite_batch_outline(SDL_Renderer *renderer, const SDL_FRect *rect, SDL_Color color);
+
+/* Draws whatever is pending */
+void sprite_batch_flush(void);
+/* Flushes and closes the frame's counts; call before SDL_RenderPresent */
+void sprite_batch_end_frame(void);
+/* Last frame's totals */
+void sprite_batch_stats(int *quads, int *draw_calls);
+
+#endif // SPRITE_BATCH_H
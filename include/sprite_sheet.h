@@ -0,0 +1,26 @@
+#ifndef SPRITE_SHEET_H
+#define SPRITE_SHEET_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+/* A horizontal strip of animation frames. The pixel size is always known;
+ * the texture is only created when a renderer is supplied, so the fight
+ * logic (which slices frames by sheet width) can run without a window.
+ * A sheet may live inside a shared atlas texture, in which case `region`
+ * is where its pixels are and the texture belongs to the atlas. */
+typedef struct
+{
+    SDL_Texture *texture; /* NULL when loaded headless */
+    int w, h;
+    SDL_Rect region;     /* sheet bounds inside `texture` */
+    bool shared_texture; /* texture is an atlas page, not ours to free */
+} SpriteSheet;
+
+SpriteSheet *create_sprite_sheet(SDL_Renderer *renderer, const char *path);
+void destroy_sprite_sheet(SpriteSheet *sheet);
+
+/* Source rectangle (in texture space) of one frame of an evenly split strip */
+SDL_Rect sprite_sheet_frame(const SpriteSheet *sheet, int frame, int frame_count);
+
+#endif // SPRITE_SHEET_H
@@ -0,0 +1,25 @@
+#ifndef TEXTURE_ATLAS_H
+#define TEXTURE_ATLAS_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+#define FIGHTER_TEXTURE_DIR "assets/textures/Final"
+
+/* Packs sprite sheets into as few textures ("pages") as the renderer's
+ * maximum texture size allows and registers every packed sheet in the
+ * asset cache, so fighters created afterwards draw from shared pages and
+ * consecutive fighter draws need no texture switch. Sheets that do not fit
+ * on any page are left for the cache to load on their own.
+ * While the asset loader is running the work is queued on it instead and
+ * the sheets appear in the cache once their page is uploaded. */
+bool texture_atlas_build(SDL_Renderer *renderer, const char *const *paths, int count);
+
+/* Packs every .bmp directly inside `dir` plus `extra` paths */
+bool texture_atlas_build_dir(SDL_Renderer *renderer, const char *dir,
+                             const char *const *extra, int extra_count);
+
+/* Destroys the page textures; call after asset_cache_clear() */
+void texture_atlas_destroy_all(void);
+
+#endif // TEXTURE_ATLAS_H
@@ -0,0 +1,295 @@
+#include "ai_search.h"
+#include "profiler.h"
+#include <math.h>
+#include <string.h>
+
+/* Budgets sized so easy sees the first pass or two, normal every single
+ * action at full length and hard about half the pairs. A step costs well
+ * under a microsecond in an optimized build; a slower one hits the clock
+ * limit first and searches less deep. */
+const AiBudget ai_budgets[AI_LEVEL_COUNT] = {
+    [AI_CLASSIC] = {0, 0},
+    [AI_EASY] = {40, 400},
+    [AI_NORMAL] = {150, 1500},
+    [AI_HARD] = {600, 6000},
+};
+
+static const char *const level_names[AI_LEVEL_COUNT] = {
+    [AI_CLASSIC] = "classic",
+    [AI_EASY] = "easy",
+    [AI_NORMAL] = "normal",
+    [AI_HARD] = "hard",
+};
+
+/* What the opponent can do, each a short script of buttons */
+typedef enum
+{
+    ACT_WAIT,
+    ACT_ADVANCE,
+    ACT_RETREAT,
+    ACT_BLOCK,
+    ACT_ATTACK, /* one swing */
+    ACT_COMBO,  /* attack held: chains as soon as it can */
+    ACT_JUMP,
+    ACT_JUMP_ATTACK,
+    ACT_DOWN_ATTACK,
+    ACT_SLIDE_IN,
+    ACT_SLIDE_OUT,
+    ACT_COUNT
+} AiAction;
+
+/* Candidate 0 carries on with the action under way; 1 + a starts action a */
+#define CANDIDATES (1 + ACT_COUNT)
+
+/* A decision holds for this many steps before the next search */
+#define REPLAN_STEPS 3
+/* Steps into a jump before the air attacks go off */
+#define JUMP_ATTACK_AT 6
+#define DOWN_ATTACK_AT 12
+
+/* Each pass looks `steps` ahead; one with `split` plays a second action
+ * (every candidate again) from that step on */
+static const struct
+{
+    Uint8 steps, split;
+} passes[] = {{24, 0}, {40, 0}, {56, 0}, {60, 20}};
+#define PASS_COUNT (int)(sizeof(passes) / sizeof(passes[0]))
+
+/* Scoring: health first, then a win outright; spacing and facing break
+ * ties between moves that change nothing yet */
+#define DAMAGE_VALUE 200
+#define WIN_VALUE 100000
+#define SPACING_PX_PER_POINT 10.0f
+#define FACING_VALUE 20
+/* Ending up behind a block has to have saved health to be worth it, or a
+ * search that sees nothing coming turtles */
+#define BLOCKING_COST 30
+/* The clock is read once per this many simulated steps */
+#define CLOCK_CHECK_STEPS 8
+
+static FighterInput action_input(AiAction action, int tick, const FighterStore *f, int self, int foe)
+{
+    bool foe_right = f->x[foe] > f->x[self];
+    FighterInput toward = foe_right ? INPUT_RIGHT : INPUT_LEFT;
+    FighterInput away = foe_right ? INPUT_LEFT : INPUT_RIGHT;
+    bool facing = (f->direction[self] == FACING_RIGHT) == foe_right;
+
+    switch (action)
+    {
+    case ACT_ADVANCE:
+        return toward;
+    case ACT_RETREAT:
+        return away;
+    case ACT_BLOCK:
+        return INPUT_BLOCK;
+    case ACT_ATTACK:
+        /* Walking is what turns a fighter; a press attacks once */
+        if (!facing)
+            return toward;
+        return tick < 2 ? INPUT_ATTACK : 0;
+    case ACT_COMBO:
+        return facing ? INPUT_ATTACK : toward;
+    case ACT_JUMP:
+        return tick == 0 ? (FighterInput)(toward | INPUT_JUMP) : toward;
+    case ACT_JUMP_ATTACK:
+        if (tick == 0)
+            return (FighterInput)(toward | INPUT_JUMP);
+        return tick < JUMP_ATTACK_AT || !facing ? toward : INPUT_ATTACK;
+    case ACT_DOWN_ATTACK:
+        if (tick == 0)
+            return (FighterInput)(toward | INPUT_JUMP);
+        return tick < DOWN_ATTACK_AT ? toward : (FighterInput)(toward | INPUT_DOWN_ATTACK);
+    case ACT_SLIDE_IN:
+        return (FighterInput)(toward | INPUT_SLIDE);
+    case ACT_SLIDE_OUT:
+        return (FighterInput)(away | INPUT_SLIDE);
+    default:
+        return 0;
+    }
+}
+
+typedef struct
+{
+    AiSearch *ai;
+    const SimState *root;
+    Uint32 steps, max_steps;
+    Uint64 deadline; /* 0 without a clock limit */
+} Search;
+
+static int score(const Search *search, const SimState *end)
+{
+    const AiSearch *ai = search->ai;
+    int self_side = ai->self == search->root->p1 ? 0 : 1;
+    int dealt = sim_health(search->root, 1 - self_side) - sim_health(end, 1 - self_side);
+    int taken = sim_health(search->root, self_side) - sim_health(end, self_side);
+    int value = (dealt - taken) * DAMAGE_VALUE;
+    if (sim_fight_over(end))
+        value += sim_winner(end) == self_side + 1 ? WIN_VALUE : -WIN_VALUE;
+
+    const FighterStore *f = &end->fighters;
+    float gap = fabsf(f->x[ai->foe] - f->x[ai->self]);
+    value -= (int)(fabsf(gap - f->ai[ai->self].attack_range) / SPACING_PX_PER_POINT);
+    if ((f->direction[ai->self] == FACING_RIGHT) == (f->x[ai->foe] > f->x[ai->self]))
+        value += FACING_VALUE;
+    if (f->flags[ai->self] & FIGHTER_IS_BLOCKING)
+        value -= BLOCKING_COST;
+    return value;
+}
+
+/* Where candidate `c` starts: the action and how far into it */
+static void candidate_action(const AiSearch *ai, int c, AiAction *action, int *tick)
+{
+    *action = c == 0 ? (AiAction)ai->action : (AiAction)(c - 1);
+    *tick = c == 0 ? ai->action_tick : 0;
+}
+
+/* Plays candidate `first`, then from step `split` candidate `second` (if
+ * split > 0; candidate 0 then just keeps `first` going), for `steps`
+ * steps against the foe holding its buttons. False if the budget ran out
+ * on the way. */
+static bool rollout(Search *search, int first, int second, int split, int steps, int *value)
+{
+    const AiSearch *ai = search->ai;
+    SimState sim;
+    sim_save(search->root, &sim);
+    FighterInput inputs[MAX_FIGHTERS] = {0};
+    inputs[ai->foe] = search->root->fighters.input[ai->foe];
+
+    AiAction action;
+    int tick;
+    candidate_action(ai, first, &action, &tick);
+    for (int t = 0; t < steps && !sim_fight_over(&sim); ++t, ++tick)
+    {
+        if (search->steps >= search->max_steps)
+            return false;
+        if (search->deadline && search->steps % CLOCK_CHECK_STEPS == 0 &&
+            SDL_GetPerformanceCounter() >= search->deadline)
+            return false;
+        if (split > 0 && t == split && second != 0)
+            candidate_action(ai, second, &action, &tick);
+
+        inputs[ai->self] = action_input(action, tick, &sim.fighters, ai->self, ai->foe);
+        sim_lookahead_step(&sim, inputs);
+        search->steps++;
+    }
+    *value = score(search, &sim);
+    return true;
+}
+
+/* Candidate order for the next pass: best first, ties in the old order */
+static void rank(int *order, int count, const int *values)
+{
+    for (int i = 1; i < count; ++i)
+    {
+        int c = order[i], j = i;
+        for (; j > 0 && values[order[j - 1]] < values[c]; --j)
+            order[j] = order[j - 1];
+        order[j] = c;
+    }
+}
+
+/* Returns the best candidate found within the budget */
+static int search_best(Search *search)
+{
+    int order[CANDIDATES];
+    for (int c = 0; c < CANDIDATES; ++c)
+        order[c] = c;
+    int values[CANDIDATES];
+    int best = 0;
+
+    for (int p = 0; p < PASS_COUNT; ++p)
+    {
+        int split = passes[p].split;
+        int seconds = split > 0 ? CANDIDATES : 1;
+        int pass_best = -1, pass_value = 0;
+        for (int i = 0; i < CANDIDATES; ++i)
+        {
+            int first = order[i];
+            values[first] = -WIN_VALUE * 2;
+            for (int k = 0; k < seconds; ++k)
+            {
+                int value;
+                if (!rollout(search, first, order[k], split, passes[p].steps, &value))
+                {
+                    /* The pass began with the last best, so what it has
+                     * seen so far already knows more than the last pass */
+                    if (pass_best >= 0)
+                        best = pass_best;
+                    search->ai->cut_short++;
+                    return best;
+                }
+                if (value > values[first])
+                    values[first] = value;
+                if (pass_best < 0 || value > pass_value)
+                {
+                    pass_best = first;
+                    pass_value = value;
+                }
+            }
+        }
+        best = pass_best;
+        rank(order, CANDIDATES, values);
+    }
+    return best;
+}
+
+void ai_search_init(AiSearch *ai, const SimState *sim, AiLevel level, bool use_clock)
+{
+    memset(ai, 0, sizeof(*ai));
+    ai->self = sim->p2;
+    ai->foe = sim->p1;
+    ai->level = level;
+    ai->use_clock = use_clock;
+    ai->action = ACT_WAIT;
+}
+
+FighterInput ai_search_input(AiSearch *ai, const SimState *sim)
+{
+    if (sim_fight_over(sim))
+        return 0;
+
+    if (ai->replan_in == 0)
+    {
+        ProfScope scope = prof_begin(PROF_SEARCH);
+        const AiBudget *budget = &ai_budgets[ai->level];
+        Uint64 start = SDL_GetPerformanceCounter();
+        Search search = {ai, sim, 0, budget->max_steps, 0};
+        if (ai->use_clock)
+            search.deadline = start + SDL_GetPerformanceFrequency() * budget->budget_us / 1000000;
+
+        int best = search_best(&search);
+        if (best != 0)
+        {
+            ai->action = (Uint8)(best - 1);
+            ai->action_tick = 0;
+        }
+        ai->replan_in = REPLAN_STEPS;
+
+        Uint64 elapsed = SDL_GetPerformanceCounter() - start;
+        ai->searches++;
+        ai->steps += search.steps;
+        ai->time += elapsed;
+        if (elapsed > ai->slowest)
+            ai->slowest = elapsed;
+        prof_end(scope);
+    }
+    ai->replan_in--;
+
+    FighterInput in = action_input((AiAction)ai->action, ai->action_tick, &sim->fighters, ai->self, ai->foe);
+    if (ai->action_tick < 0xFFFF)
+        ai->action_tick++;
+    return in;
+}
+
+const char *ai_level_name(AiLevel level)
+{
+    return level < AI_LEVEL_COUNT ? level_names[level] : "?";
+}
+
+int ai_level_find(const char *name)
+{
+    for (int i = 0; i < AI_LEVEL_COUNT; ++i)
+        if (strcmp(level_names[i], name) == 0)
+            return i;
+    return -1;
+}
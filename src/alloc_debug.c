@@ -0,0 +1,63 @@
+#include "alloc_debug.h"
+#include <SDL2/SDL.h>
+#include <stddef.h>
+
+#ifdef SMACK_ALLOC_DEBUG
+
+/* Linked with -Wl,--wrap=malloc,... so every call to malloc() in our
+ * objects lands in __wrap_malloc and the real one is __real_malloc */
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+void __real_free(void *ptr);
+
+static SDL_atomic_t heap_calls;
+
+void *__wrap_malloc(size_t size)
+{
+    SDL_AtomicIncRef(&heap_calls);
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size)
+{
+    SDL_AtomicIncRef(&heap_calls);
+    return __real_calloc(count, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size)
+{
+    SDL_AtomicIncRef(&heap_calls);
+    return __real_realloc(ptr, size);
+}
+
+void __wrap_free(void *ptr)
+{
+    if (ptr)
+        SDL_AtomicIncRef(&heap_calls);
+    __real_free(ptr);
+}
+
+bool alloc_debug_enabled(void)
+{
+    return true;
+}
+
+int alloc_debug_count(void)
+{
+    return SDL_AtomicGet(&heap_calls);
+}
+
+#else
+
+bool alloc_debug_enabled(void)
+{
+    return false;
+}
+
+int alloc_debug_count(void)
+{
+    return 0;
+}
+
+#endif
@@ -0,0 +1,182 @@
+#include "asset_cache.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct
+{
+    char *path;
+    Uint32 hash;
+    int refs;
+    SpriteSheet *sheet;
+} CacheEntry;
+
+static CacheEntry *entries = NULL;
+static int entry_count = 0;
+static int entry_capacity = 0;
+
+static Uint32 hash_path(const char *path)
+{
+    /* FNV-1a */
+    Uint32 h = 2166136261u;
+    for (const unsigned char *p = (const unsigned char *)path; *p; ++p)
+        h = (h ^ *p) * 16777619u;
+    return h;
+}
+
+static CacheEntry *find_by_path(const char *path, Uint32 hash)
+{
+    for (int i = 0; i < entry_count; ++i)
+        if (entries[i].hash == hash && strcmp(entries[i].path, path) == 0)
+            return &entries[i];
+    return NULL;
+}
+
+static CacheEntry *find_by_sheet(const SpriteSheet *sheet)
+{
+    for (int i = 0; i < entry_count; ++i)
+        if (entries[i].sheet == sheet)
+            return &entries[i];
+    return NULL;
+}
+
+/* Appends an unreferenced entry; the cache takes ownership of `sheet` */
+static CacheEntry *add_entry(const char *path, Uint32 hash, SpriteSheet *sheet)
+{
+    if (entry_count == entry_capacity)
+    {
+        int capacity = entry_capacity ? entry_capacity * 2 : 32;
+        CacheEntry *grown = (CacheEntry *)realloc(entries, capacity * sizeof(CacheEntry));
+        if (!grown)
+        {
+            fprintf(stderr, "Asset cache: out of memory\n");
+            return NULL;
+        }
+        entries = grown;
+        entry_capacity = capacity;
+    }
+
+    size_t len = strlen(path) + 1;
+    char *key = (char *)malloc(len);
+    if (!key)
+        return NULL;
+    memcpy(key, path, len);
+
+    CacheEntry *entry = &entries[entry_count++];
+    entry->path = key;
+    entry->hash = hash;
+    entry->refs = 0;
+    entry->sheet = sheet;
+    return entry;
+}
+
+SpriteSheet *asset_cache_acquire(SDL_Renderer *renderer, const char *path)
+{
+    Uint32 hash = hash_path(path);
+    CacheEntry *entry = find_by_path(path, hash);
+
+    if (entry)
+    {
+        /* A sheet first loaded headless has no texture yet; upgrade it in
+         * place so existing holders see the texture too. */
+        if (renderer && !entry->sheet->texture)
+        {
+            SpriteSheet *full = create_sprite_sheet(renderer, path);
+            if (!full)
+                return NULL;
+            *entry->sheet = *full;
+            free(full);
+        }
+        entry->refs++;
+        return entry->sheet;
+    }
+
+    SpriteSheet *sheet = create_sprite_sheet(renderer, path);
+    if (!sheet)
+        return NULL;
+
+    entry = add_entry(path, hash, sheet);
+    if (!entry)
+    {
+        destroy_sprite_sheet(sheet);
+        return NULL;
+    }
+    entry->refs = 1;
+    return sheet;
+}
+
+bool asset_cache_insert(const char *path, SpriteSheet *sheet)
+{
+    Uint32 hash = hash_path(path);
+    if (find_by_path(path, hash))
+        return false;
+    return add_entry(path, hash, sheet) != NULL;
+}
+
+bool asset_cache_contains(const char *path)
+{
+    return find_by_path(path, hash_path(path)) != NULL;
+}
+
+bool asset_cache_reload(SDL_Renderer *renderer, const char *path)
+{
+    CacheEntry *entry = find_by_path(path, hash_path(path));
+    if (!entry)
+        return false;
+    SpriteSheet *fresh = create_sprite_sheet(renderer, path);
+    if (!fresh)
+        return false;
+
+    /* An atlas region becomes a texture of its own; the page keeps the old pixels */
+    SpriteSheet *sheet = entry->sheet;
+    if (sheet->texture && !sheet->shared_texture)
+        SDL_DestroyTexture(sheet->texture);
+    *sheet = *fresh;
+    free(fresh);
+    return true;
+}
+
+void asset_cache_release(SpriteSheet *sheet)
+{
+    if (!sheet)
+        return;
+    CacheEntry *entry = find_by_sheet(sheet);
+    if (!entry)
+    {
+        fprintf(stderr, "Asset cache: releasing a sheet it does not own\n");
+        return;
+    }
+    if (entry->refs > 0)
+        entry->refs--;
+}
+
+void asset_cache_purge(void)
+{
+    int kept = 0;
+    for (int i = 0; i < entry_count; ++i)
+    {
+        if (entries[i].refs > 0)
+        {
+            entries[kept++] = entries[i];
+            continue;
+        }
+        destroy_sprite_sheet(entries[i].sheet);
+        free(entries[i].path);
+    }
+    entry_count = kept;
+}
+
+void asset_cache_clear(void)
+{
+    for (int i = 0; i < entry_count; ++i)
+    {
+        if (entries[i].refs > 0)
+            fprintf(stderr, "Asset cache: %s still has %d holder(s) at shutdown\n",
+                    entries[i].path, entries[i].refs);
+        destroy_sprite_sheet(entries[i].sheet);
+        free(entries[i].path);
+    }
+    free(entries);
+    entries = NULL;
+    entry_count = entry_capacity = 0;
+}
@@ -0,0 +1,348 @@
+#include "asset_loader.h"
+#include "asset_pack.h"
+#include "profiler.h"
+#include <SDL2/SDL_image.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Bytes uploaded per SDL_UpdateTexture call; small enough that a band
+ * never blows a frame's budget on its own */
+#define UPLOAD_BAND_BYTES (512 * 1024)
+
+typedef struct LoadJob
+{
+    AssetDecodeFn decode;
+    void *user;
+    struct LoadJob *next;
+} LoadJob;
+
+typedef struct Delivery
+{
+    SDL_Surface *surface; /* to upload, or NULL to pass `asset` through */
+    void *asset;
+    AssetReadyFn ready;
+    void *user;
+    struct Delivery *next;
+} Delivery;
+
+typedef struct
+{
+    char *path;
+    AssetReadyFn ready;
+    void *user;
+} ImageJob;
+
+static SDL_Thread *worker = NULL;
+static SDL_mutex *lock = NULL;
+static SDL_cond *wake = NULL;
+static bool quitting = false;
+
+/* Shared with the worker, guarded by `lock` */
+static LoadJob *job_head = NULL, *job_tail = NULL;
+static Delivery *done_head = NULL, *done_tail = NULL;
+static int jobs_pending = 0;       /* queued or decoding */
+static int deliveries_pending = 0; /* delivered, not yet handed to the owner */
+static int completed = 0;
+
+/* Main thread only: the delivery being uploaded band by band */
+static Delivery *uploading = NULL;
+static SDL_Texture *upload_texture = NULL;
+static int upload_row = 0;
+
+static int worker_main(void *data)
+{
+    (void)data;
+    SDL_LockMutex(lock);
+    for (;;)
+    {
+        while (!job_head && !quitting)
+            SDL_CondWait(wake, lock);
+        if (!job_head)
+            break; /* quitting and drained */
+
+        LoadJob *job = job_head;
+        job_head = job->next;
+        if (!job_head)
+            job_tail = NULL;
+        SDL_UnlockMutex(lock);
+
+        ProfScope scope = prof_begin(PROF_DECODE);
+        job->decode(job->user);
+        prof_end(scope);
+        free(job);
+
+        SDL_LockMutex(lock);
+        jobs_pending--;
+        completed++;
+    }
+    SDL_UnlockMutex(lock);
+    return 0;
+}
+
+bool asset_loader_start(void)
+{
+    if (worker)
+        return true;
+
+    lock = SDL_CreateMutex();
+    wake = SDL_CreateCond();
+    quitting = false;
+    if (lock && wake)
+        worker = SDL_CreateThread(worker_main, "asset_loader", NULL);
+    if (!worker)
+    {
+        fprintf(stderr, "Asset loader could not start: %s\n", SDL_GetError());
+        if (wake)
+            SDL_DestroyCond(wake);
+        if (lock)
+            SDL_DestroyMutex(lock);
+        wake = NULL;
+        lock = NULL;
+        return false;
+    }
+    return true;
+}
+
+void asset_loader_stop(SDL_Renderer *renderer)
+{
+    if (!worker)
+        return;
+
+    SDL_LockMutex(lock);
+    quitting = true;
+    SDL_CondSignal(wake);
+    SDL_UnlockMutex(lock);
+    SDL_WaitThread(worker, NULL);
+    worker = NULL;
+
+    while (!asset_loader_idle())
+        asset_loader_pump(renderer, 1000000);
+
+    SDL_DestroyCond(wake);
+    SDL_DestroyMutex(lock);
+    wake = NULL;
+    lock = NULL;
+    completed = 0;
+}
+
+bool asset_loader_running(void)
+{
+    return worker != NULL;
+}
+
+void asset_loader_queue(AssetDecodeFn decode, void *user)
+{
+    if (!worker)
+    {
+        fprintf(stderr, "Asset loader: queue called while stopped\n");
+        return;
+    }
+    LoadJob *job = (LoadJob *)malloc(sizeof(LoadJob));
+    if (!job)
+    {
+        /* Decode inline; the deliveries still go through the next pump */
+        decode(user);
+        return;
+    }
+    job->decode = decode;
+    job->user = user;
+    job->next = NULL;
+
+    SDL_LockMutex(lock);
+    if (job_tail)
+        job_tail->next = job;
+    else
+        job_head = job;
+    job_tail = job;
+    jobs_pending++;
+    SDL_CondSignal(wake);
+    SDL_UnlockMutex(lock);
+}
+
+static void push_delivery(SDL_Surface *surface, void *asset, AssetReadyFn ready, void *user)
+{
+    Delivery *d = (Delivery *)malloc(sizeof(Delivery));
+    if (!d)
+    {
+        fprintf(stderr, "Asset loader: out of memory, dropping a delivery\n");
+        SDL_FreeSurface(surface);
+        return;
+    }
+    d->surface = surface;
+    d->asset = asset;
+    d->ready = ready;
+    d->user = user;
+    d->next = NULL;
+
+    SDL_LockMutex(lock);
+    if (done_tail)
+        done_tail->next = d;
+    else
+        done_head = d;
+    done_tail = d;
+    deliveries_pending++;
+    SDL_UnlockMutex(lock);
+}
+
+void asset_loader_deliver_surface(SDL_Surface *surface, AssetReadyFn ready, void *user)
+{
+    push_delivery(surface, NULL, ready, user);
+}
+
+void asset_loader_deliver(void *asset, AssetReadyFn ready, void *user)
+{
+    push_delivery(NULL, asset, ready, user);
+}
+
+/* Worker side of asset_loader_queue_image */
+static void decode_image(void *data)
+{
+    ImageJob *job = (ImageJob *)data;
+
+    SDL_Surface *surface = asset_pack_surface(job->path);
+    if (surface)
+    {
+        /* Fault the mapped pages in here so the upload never waits on disk */
+        volatile Uint8 sink = 0;
+        const Uint8 *pixels = (const Uint8 *)surface->pixels;
+        size_t size = (size_t)surface->pitch * surface->h;
+        for (size_t i = 0; i < size; i += 4096)
+            sink ^= pixels[i];
+        (void)sink;
+    }
+    else
+    {
+        SDL_Surface *decoded = IMG_Load_RW(asset_pack_rw(job->path), 1);
+        if (!decoded)
+            fprintf(stderr, "Failed to load image %s: %s\n", job->path, IMG_GetError());
+        else if (decoded->format->format == SDL_PIXELFORMAT_RGBA32)
+            surface = decoded;
+        else
+        {
+            surface = SDL_ConvertSurfaceFormat(decoded, SDL_PIXELFORMAT_RGBA32, 0);
+            SDL_FreeSurface(decoded);
+        }
+    }
+
+    if (surface)
+        asset_loader_deliver_surface(surface, job->ready, job->user);
+    else
+        asset_loader_deliver(NULL, job->ready, job->user);
+    free(job->path);
+    free(job);
+}
+
+void asset_loader_queue_image(const char *path, AssetReadyFn ready, void *user)
+{
+    ImageJob *job = (ImageJob *)malloc(sizeof(ImageJob));
+    char *copy = job ? (char *)malloc(strlen(path) + 1) : NULL;
+    if (!copy)
+    {
+        free(job);
+        fprintf(stderr, "Asset loader: out of memory queueing %s\n", path);
+        ready(user, NULL);
+        return;
+    }
+    strcpy(copy, path);
+    job->path = copy;
+    job->ready = ready;
+    job->user = user;
+    asset_loader_queue(decode_image, job);
+}
+
+/* Uploads the next band of the current delivery; true once it is complete */
+static bool upload_band(SDL_Renderer *renderer)
+{
+    SDL_Surface *s = uploading->surface;
+    if (!s)
+        return true;
+
+    if (!upload_texture)
+    {
+        upload_texture = SDL_CreateTexture(renderer, s->format->format, SDL_TEXTUREACCESS_STATIC, s->w, s->h);
+        if (!upload_texture)
+        {
+            fprintf(stderr, "Asset loader: texture creation failed: %s\n", SDL_GetError());
+            return true;
+        }
+        SDL_SetTextureBlendMode(upload_texture, SDL_BLENDMODE_BLEND);
+        upload_row = 0;
+    }
+
+    int rows = UPLOAD_BAND_BYTES / (s->pitch > 0 ? s->pitch : 1);
+    if (rows < 1)
+        rows = 1;
+    if (rows > s->h - upload_row)
+        rows = s->h - upload_row;
+    SDL_Rect band = {0, upload_row, s->w, rows};
+    SDL_UpdateTexture(upload_texture, &band, (const Uint8 *)s->pixels + (size_t)s->pitch * upload_row, s->pitch);
+    upload_row += rows;
+    return upload_row >= s->h;
+}
+
+static void finish_delivery(void)
+{
+    Delivery *d = uploading;
+    void *asset = d->surface ? (void *)upload_texture : d->asset;
+    SDL_FreeSurface(d->surface);
+    uploading = NULL;
+    upload_texture = NULL;
+    upload_row = 0;
+
+    d->ready(d->user, asset);
+    free(d);
+
+    SDL_LockMutex(lock);
+    deliveries_pending--;
+    completed++;
+    SDL_UnlockMutex(lock);
+}
+
+void asset_loader_pump(SDL_Renderer *renderer, Uint32 budget_us)
+{
+    if (!lock)
+        return;
+
+    Uint64 deadline = SDL_GetPerformanceCounter() + SDL_GetPerformanceFrequency() * budget_us / 1000000;
+    do
+    {
+        if (!uploading)
+        {
+            SDL_LockMutex(lock);
+            uploading = done_head;
+            if (done_head)
+            {
+                done_head = done_head->next;
+                if (!done_head)
+                    done_tail = NULL;
+            }
+            SDL_UnlockMutex(lock);
+            if (!uploading)
+                break;
+        }
+        if (upload_band(renderer))
+            finish_delivery();
+    } while (SDL_GetPerformanceCounter() < deadline);
+}
+
+bool asset_loader_idle(void)
+{
+    if (!lock)
+        return true;
+    SDL_LockMutex(lock);
+    bool idle = jobs_pending == 0 && deliveries_pending == 0;
+    SDL_UnlockMutex(lock);
+    return idle;
+}
+
+float asset_loader_progress(void)
+{
+    if (!lock)
+        return 1.0f;
+    SDL_LockMutex(lock);
+    int total = completed + jobs_pending + deliveries_pending;
+    float progress = total > 0 ? (float)completed / (float)total : 1.0f;
+    SDL_UnlockMutex(lock);
+    return progress;
+}
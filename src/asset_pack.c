@@ -0,0 +1,194 @@
+#include "asset_pack.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const Uint8 *pack_base = NULL;
+static size_t pack_size = 0;
+static const AssetPackEntry *pack_entries = NULL;
+static Uint32 pack_count = 0;
+
+#ifdef _WIN32
+static HANDLE pack_mapping = NULL;
+
+static const Uint8 *map_file(const char *path, size_t *size)
+{
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return NULL;
+
+    LARGE_INTEGER len;
+    const Uint8 *base = NULL;
+    if (GetFileSizeEx(file, &len) && len.QuadPart > 0)
+    {
+        pack_mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (pack_mapping)
+            base = (const Uint8 *)MapViewOfFile(pack_mapping, FILE_MAP_READ, 0, 0, 0);
+        *size = (size_t)len.QuadPart;
+    }
+    CloseHandle(file); /* the mapping keeps the file open */
+    return base;
+}
+
+static void unmap_file(void)
+{
+    UnmapViewOfFile(pack_base);
+    CloseHandle(pack_mapping);
+    pack_mapping = NULL;
+}
+#else
+static const Uint8 *map_file(const char *path, size_t *size)
+{
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return NULL;
+
+    struct stat st;
+    void *base = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size > 0)
+    {
+        base = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        *size = (size_t)st.st_size;
+    }
+    close(fd); /* the mapping keeps the file open */
+    return base == MAP_FAILED ? NULL : (const Uint8 *)base;
+}
+
+static void unmap_file(void)
+{
+    munmap((void *)pack_base, pack_size);
+}
+#endif
+
+/* Reject anything that would make us read outside the mapping */
+static bool validate(const Uint8 *base, size_t size)
+{
+    if (SDL_BYTEORDER != SDL_LIL_ENDIAN)
+        return false; /* records are read in place */
+    if (size < sizeof(AssetPackHeader))
+        return false;
+
+    const AssetPackHeader *header = (const AssetPackHeader *)base;
+    if (header->magic != ASSET_PACK_MAGIC || header->version != ASSET_PACK_VERSION)
+        return false;
+    if (header->entry_count > (size - sizeof(AssetPackHeader)) / sizeof(AssetPackEntry))
+        return false;
+
+    const AssetPackEntry *entries = (const AssetPackEntry *)(base + sizeof(AssetPackHeader));
+    for (Uint32 i = 0; i < header->entry_count; ++i)
+    {
+        const AssetPackEntry *e = &entries[i];
+        if (memchr(e->path, '\0', ASSET_PACK_NAME_MAX) == NULL)
+            return false;
+        if (e->offset % ASSET_PACK_ALIGN != 0 || e->offset > size || e->size > size - e->offset)
+            return false;
+        if (e->kind == PACK_ENTRY_PIXELS && (Uint64)e->w * e->h * 4 != e->size)
+            return false;
+        if (i > 0 && strcmp(entries[i - 1].path, e->path) >= 0)
+            return false; /* must be sorted for the binary search */
+    }
+    return true;
+}
+
+bool asset_pack_open(const char *path)
+{
+    asset_pack_close();
+
+    size_t size = 0;
+    const Uint8 *base = map_file(path, &size);
+    if (!base)
+        return false;
+
+    pack_base = base;
+    pack_size = size;
+    if (!validate(base, size))
+    {
+        fprintf(stderr, "Asset pack %s is invalid or out of date; using loose files\n", path);
+        asset_pack_close();
+        return false;
+    }
+
+    pack_entries = (const AssetPackEntry *)(base + sizeof(AssetPackHeader));
+    pack_count = ((const AssetPackHeader *)base)->entry_count;
+    return true;
+}
+
+void asset_pack_close(void)
+{
+    if (pack_base)
+        unmap_file();
+    pack_base = NULL;
+    pack_size = 0;
+    pack_entries = NULL;
+    pack_count = 0;
+}
+
+bool asset_pack_is_open(void)
+{
+    return pack_base != NULL;
+}
+
+const AssetPackEntry *asset_pack_find(const char *path)
+{
+    Uint32 lo = 0, hi = pack_count;
+    while (lo < hi)
+    {
+        Uint32 mid = lo + (hi - lo) / 2;
+        int cmp = strcmp(path, pack_entries[mid].path);
+        if (cmp == 0)
+            return &pack_entries[mid];
+        if (cmp < 0)
+            hi = mid;
+        else
+            lo = mid + 1;
+    }
+    return NULL;
+}
+
+const void *asset_pack_data(const AssetPackEntry *entry)
+{
+    return pack_base + entry->offset;
+}
+
+SDL_Surface *asset_pack_surface(const char *path)
+{
+    const AssetPackEntry *e = asset_pack_find(path);
+    if (!e || e->kind != PACK_ENTRY_PIXELS)
+        return NULL;
+    /* SDL wants a non-const pointer but only reads it for uploads and blits */
+    return SDL_CreateRGBSurfaceWithFormatFrom((void *)asset_pack_data(e), (int)e->w, (int)e->h,
+                                              32, (int)e->w * 4, e->format);
+}
+
+SDL_RWops *asset_pack_rw(const char *path)
+{
+    const AssetPackEntry *e = asset_pack_find(path);
+    if (e && e->kind == PACK_ENTRY_RAW)
+        return SDL_RWFromConstMem(asset_pack_data(e), (int)e->size);
+    return SDL_RWFromFile(path, "rb");
+}
+
+int asset_pack_list(const char *dir, const char **paths, int max)
+{
+    size_t len = strlen(dir);
+    int count = 0;
+    for (Uint32 i = 0; i < pack_count && count < max; ++i)
+    {
+        const AssetPackEntry *e = &pack_entries[i];
+        if (e->kind == PACK_ENTRY_PIXELS && strncmp(e->path, dir, len) == 0 &&
+            e->path[len] == '/' && strchr(e->path + len + 1, '/') == NULL)
+            paths[count++] = e->path;
+    }
+    return count;
+}
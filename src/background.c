@@ -1,37 +1,73 @@
 #include "background.h"
+#include "asset_loader.h"
+#include "asset_pack.h"
+#include "sprite_batch.h"
 #include <stdio.h>
 #include <stdlib.h>
 
-Background *create_background(SDL_Renderer *ren, const char *path,
-                              int total_frames, Uint32 frame_delay)
+/* Packed images are already decoded; anything else goes through SDL_image */
+static SDL_Texture *load_texture(SDL_Renderer *ren, const char *path)
 {
-    Background *bg = (Background *)malloc(sizeof(Background));
-    if (!bg)
+    SDL_Surface *surface = asset_pack_surface(path);
+    if (surface)
     {
-        fprintf(stderr, "Failed to allocate background\n");
-        return NULL;
+        SDL_Texture *texture = SDL_CreateTextureFromSurface(ren, surface);
+        SDL_FreeSurface(surface);
+        return texture;
     }
+    return IMG_LoadTexture_RW(ren, asset_pack_rw(path), 1);
+}
 
-    bg->texture = IMG_LoadTexture(ren, path);
+static void background_loaded(void *user, void *asset)
+{
+    Background *bg = (Background *)user;
+    bg->texture = (SDL_Texture *)asset;
     if (!bg->texture)
-    {
-        fprintf(stderr, "IMG_LoadTexture Error: %s\n", IMG_GetError());
-        free(bg);
-        return NULL;
-    }
+        return;
 
     // Get full texture dimensions
     int tex_width, tex_height;
     SDL_QueryTexture(bg->texture, NULL, NULL, &tex_width, &tex_height);
 
     // Calculate frame dimensions
-    bg->frame_width = tex_width / total_frames;
+    bg->frame_width = tex_width / bg->total_frames;
     bg->frame_height = tex_height;
+}
+
+Background *create_background(SDL_Renderer *ren, const char *path,
+                              int total_frames, Uint32 frame_delay)
+{
+    Background *bg = (Background *)malloc(sizeof(Background));
+    if (!bg)
+    {
+        fprintf(stderr, "Failed to allocate background\n");
+        return NULL;
+    }
+
+    bg->texture = NULL;
+    bg->frame_width = 0;
+    bg->frame_height = 0;
     bg->total_frames = total_frames;
     bg->current_frame = 0;
     bg->frame_delay = frame_delay;
     bg->last_update = SDL_GetTicks();
 
+    // With the loader running the texture arrives later; until then the
+    // background simply draws nothing
+    if (asset_loader_running())
+    {
+        asset_loader_queue_image(path, background_loaded, bg);
+        return bg;
+    }
+
+    SDL_Texture *texture = load_texture(ren, path);
+    if (!texture)
+    {
+        fprintf(stderr, "IMG_LoadTexture Error: %s\n", IMG_GetError());
+        free(bg);
+        return NULL;
+    }
+    background_loaded(bg, texture);
     return bg;
 }
 
@@ -65,13 +101,13 @@ void render_background(SDL_Renderer *ren, Background *bg)
     SDL_GetRendererOutputSize(ren, &render_w, &render_h);
 
     // Create destination rectangle to fill the screen
-    SDL_Rect dest_rect = {
-        .x = 0,
-        .y = 0,
-        .w = render_w,
-        .h = render_h};
+    SDL_FRect dest_rect = {
+        .x = 0.0f,
+        .y = 0.0f,
+        .w = (float)render_w,
+        .h = (float)render_h};
 
-    SDL_RenderCopy(ren, bg->texture, &src_rect, &dest_rect);
+    sprite_batch_sprite(ren, bg->texture, &src_rect, &dest_rect, SDL_FLIP_NONE, (SDL_Color){255, 255, 255, 255});
 }
 
 void destroy_background(Background *bg)
@@ -86,6 +122,28 @@ void destroy_background(Background *bg)
     }
 }
 
+static void button_normal_loaded(void *user, void *asset)
+{
+    Button *button = (Button *)user;
+    button->normal_texture = (SDL_Texture *)asset;
+    if (button->pending_loads > 0)
+        button->pending_loads--;
+
+    // Get texture dimensions for auto-sizing
+    if (button->normal_texture)
+    {
+        SDL_QueryTexture(button->normal_texture, NULL, NULL, &button->rect.w, &button->rect.h);
+    }
+}
+
+static void button_hover_loaded(void *user, void *asset)
+{
+    Button *button = (Button *)user;
+    button->hover_texture = (SDL_Texture *)asset;
+    if (button->pending_loads > 0)
+        button->pending_loads--;
+}
+
 // Function to create a button with auto-sizing based on image dimensions
 Button *create_button(SDL_Renderer *ren, int x, int y,
                       const char *normal_bmp, const char *hover_bmp)
@@ -99,22 +157,24 @@ Button *create_button(SDL_Renderer *ren, int x, int y,
 
     button->rect.x = x;
     button->rect.y = y;
-    button->normal_texture = IMG_LoadTexture(ren, normal_bmp);
-    button->hover_texture = IMG_LoadTexture(ren, hover_bmp);
+    button->rect.w = 100; // Default width
+    button->rect.h = 50;  // Default height
+    button->normal_texture = NULL;
+    button->hover_texture = NULL;
     button->is_hovered = false;
     button->is_pressed = false;
+    button->pending_loads = 0;
 
-    // Get texture dimensions for auto-sizing
-    if (button->normal_texture)
+    if (asset_loader_running())
     {
-        SDL_QueryTexture(button->normal_texture, NULL, NULL, &button->rect.w, &button->rect.h);
-    }
-    else
-    {
-        button->rect.w = 100; // Default width
-        button->rect.h = 50;  // Default height
+        button->pending_loads = 2;
+        asset_loader_queue_image(normal_bmp, button_normal_loaded, button);
+        asset_loader_queue_image(hover_bmp, button_hover_loaded, button);
+        return button;
     }
 
+    button->hover_texture = load_texture(ren, hover_bmp);
+    button_normal_loaded(button, load_texture(ren, normal_bmp));
     return button;
 }
 
@@ -155,24 +215,24 @@ void handle_button_event(Button *button, SDL_Event *event)
 // Function to render button
 void render_button(SDL_Renderer *ren, Button *button)
 {
-    if (!button)
-        return;
+    if (!button || button->pending_loads > 0)
+        return; // still loading: draw nothing rather than the fallback box
 
     // Choose texture based on hover state
     SDL_Texture *current_texture = button->is_hovered ? button->hover_texture : button->normal_texture;
 
+    SDL_FRect rect = {(float)button->rect.x, (float)button->rect.y, (float)button->rect.w, (float)button->rect.h};
+
     // Render button image
     if (current_texture)
     {
-        SDL_RenderCopy(ren, current_texture, NULL, &button->rect);
+        sprite_batch_sprite(ren, current_texture, NULL, &rect, SDL_FLIP_NONE, (SDL_Color){255, 255, 255, 255});
     }
     else
     {
         // Fallback: render a simple rectangle if texture loading failed
-        SDL_SetRenderDrawColor(ren, 100, 100, 100, 255);
-        SDL_RenderFillRect(ren, &button->rect);
-        SDL_SetRenderDrawColor(ren, 0, 0, 0, 255);
-        SDL_RenderDrawRect(ren, &button->rect);
+        sprite_batch_fill(ren, &rect, (SDL_Color){100, 100, 100, 255});
+        sprite_batch_outline(ren, &rect, (SDL_Color){0, 0, 0, 255});
     }
 }
 
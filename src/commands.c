@@ -0,0 +1,94 @@
+#include "commands.h"
+#include <string.h>
+
+/* Names used in the fighter definitions */
+static const char *const symbol_names[SYM_COUNT] = {
+    [SYM_FORWARD] = "forward",
+    [SYM_BACK] = "back",
+    [SYM_JUMP] = "jump",
+    [SYM_ATTACK] = "attack",
+    [SYM_DOWN_ATTACK] = "down_attack",
+    [SYM_BLOCK] = "block",
+    [SYM_SLIDE] = "slide",
+};
+
+static const char *const action_names[ACTION_COUNT] = {
+    [ACTION_DASH] = "dash",
+    [ACTION_ATTACK1] = "attack1",
+    [ACTION_ATTACK2] = "attack2",
+    [ACTION_ATTACK3] = "attack3",
+};
+
+static int find_name(const char *name, const char *const *names, int count)
+{
+    for (int i = 0; i < count; ++i)
+        if (names[i] && strcmp(names[i], name) == 0)
+            return i;
+    return -1;
+}
+
+int command_symbol_find(const char *name)
+{
+    return find_name(name, symbol_names, SYM_COUNT);
+}
+
+int command_action_find(const char *name)
+{
+    return find_name(name, action_names, ACTION_COUNT);
+}
+
+#define NO_STATE 0xFF
+
+void command_dfa_build(CommandDfa *dfa, const Command *commands, int count)
+{
+    memset(dfa->next, NO_STATE, sizeof(dfa->next));
+    memset(dfa->action, ACTION_NONE, sizeof(dfa->action));
+    dfa->state_count = 1;
+
+    /* A trie of the commands; state 0 is "nothing matched yet" */
+    for (int c = 0; c < count && c < COMMAND_MAX; ++c)
+    {
+        int s = 0;
+        for (int i = 0; i < commands[c].length && i < COMMAND_MAX_STEPS; ++i)
+        {
+            Uint8 *next = &dfa->next[s][commands[c].steps[i]];
+            if (*next == NO_STATE)
+                *next = (Uint8)dfa->state_count++;
+            s = *next;
+        }
+        if (s != 0 && dfa->action[s] == ACTION_NONE)
+            dfa->action[s] = commands[c].action;
+    }
+
+    /* Breadth first, every missing edge follows the longest suffix of the
+     * presses so far that is still the start of some command, and a state
+     * completes whatever its suffix completes */
+    Uint8 fail[COMMAND_MAX_STATES] = {0};
+    Uint8 queue[COMMAND_MAX_STATES];
+    int head = 0, tail = 0;
+    for (int sym = 0; sym < SYM_COUNT; ++sym)
+    {
+        Uint8 *next = &dfa->next[0][sym];
+        if (*next == NO_STATE)
+            *next = 0;
+        else
+            queue[tail++] = *next;
+    }
+    while (head < tail)
+    {
+        int s = queue[head++];
+        for (int sym = 0; sym < SYM_COUNT; ++sym)
+        {
+            Uint8 *next = &dfa->next[s][sym];
+            if (*next == NO_STATE)
+            {
+                *next = dfa->next[fail[s]][sym];
+                continue;
+            }
+            fail[*next] = dfa->next[fail[s]][sym];
+            if (dfa->action[*next] == ACTION_NONE)
+                dfa->action[*next] = dfa->action[fail[*next]];
+            queue[tail++] = *next;
+        }
+    }
+}
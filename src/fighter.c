@@ -0,0 +1,709 @@
+#include "fighter.h"
+#include "asset_cache.h"
+#include "frame_data.h"
+#include "sprite_batch.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+/* Screen clamp: fighters may hang this far off either edge */
+#define STAGE_MARGIN 200
+#define STAGE_WIDTH 1280
+
+#define SLIDE_SPEED_SCALE 1.2f
+#define DOWN_ATTACK_MIN_FALL 600.0f
+
+/* ---------- Archetypes ---------- */
+
+/* Tuning and animation tables are data (FIGHTER_DEFS_PATH, fighter_defs.c);
+ * the keymaps and which animation each state shows stay in code */
+
+const FighterKeymap keymap_p1 = {
+    SDL_SCANCODE_A, SDL_SCANCODE_D, SDL_SCANCODE_SPACE, SDL_SCANCODE_W,
+    SDL_SCANCODE_F, SDL_SCANCODE_S, SDL_SCANCODE_LALT, SDL_SCANCODE_RALT};
+const FighterKeymap keymap_p2 = {
+    SDL_SCANCODE_LEFT, SDL_SCANCODE_RIGHT, SDL_SCANCODE_KP_ENTER, SDL_SCANCODE_UP,
+    SDL_SCANCODE_KP_0, SDL_SCANCODE_DOWN, SDL_SCANCODE_KP_PLUS, SDL_SCANCODE_UNKNOWN};
+
+static const Uint8 state_anim[] = {
+    [FIGHTER_IDLE] = ANIM_IDLE,
+    [FIGHTER_WALKING] = ANIM_WALK,
+    [FIGHTER_JUMPING] = ANIM_JUMP,
+    [FIGHTER_ATTACKING] = ANIM_ATTACK1, /* + current_attack */
+    [FIGHTER_BLOCKING] = ANIM_BLOCK,
+    [FIGHTER_DEATH] = ANIM_DEATH,
+    [FIGHTER_HURT] = ANIM_HURT,
+    [FIGHTER_SLIDE] = ANIM_SLIDE,
+    [FIGHTER_BLOCK_HURT] = ANIM_BLOCK_HURT,
+    [FIGHTER_PRAY] = ANIM_PRAY,
+    [FIGHTER_DOWN_ATTACK] = ANIM_DOWN_ATTACK,
+    [FIGHTER_REPOSITIONING] = ANIM_REPOSITION,
+};
+
+/* Render-side sheets shared by every fighter of an archetype, and the frame
+ * widths the simulation derives from them (constant once loaded) */
+static SpriteSheet *archetype_sheets[FIGHTER_MAX_ARCHETYPES][ANIM_COUNT];
+static float anim_frame_width[FIGHTER_MAX_ARCHETYPES][ANIM_COUNT];
+static bool assets_held = false;
+
+/* ---------- Assets ---------- */
+
+bool fighter_assets_acquire(SDL_Renderer *renderer)
+{
+    if (assets_held)
+        return true;
+
+    /* Definitions first: they name the sheets, and the frame data refers to them */
+    if (!fighter_defs_loaded() && !fighter_defs_load(FIGHTER_DEFS_PATH))
+        return false;
+
+    bool ok = true;
+    for (int a = 0; a < fighter_archetype_count; ++a)
+    {
+        const FighterArchetype *arch = &fighter_archetypes[a];
+        for (int i = 0; i < ANIM_COUNT; ++i)
+        {
+            SpriteSheet *sheet = asset_cache_acquire(renderer, arch->anims[i].path);
+            archetype_sheets[a][i] = sheet;
+            anim_frame_width[a][i] = sheet ? (float)sheet->w / (float)arch->anims[i].frame_count : 0.0f;
+            if (!sheet)
+                ok = false;
+        }
+    }
+    /* Hit detection needs the boxes as much as rendering needs the sheets */
+    if (!frame_data_loaded() && !frame_data_load(FRAME_DATA_PATH))
+        ok = false;
+    assets_held = true;
+    if (!ok)
+    {
+        fprintf(stderr, "Fighters: textures or frame data failed to load.\n");
+        fighter_assets_release();
+    }
+    return ok;
+}
+
+void fighter_assets_release(void)
+{
+    if (!assets_held)
+        return;
+    for (int a = 0; a < fighter_archetype_count; ++a)
+        for (int i = 0; i < ANIM_COUNT; ++i)
+        {
+            asset_cache_release(archetype_sheets[a][i]);
+            archetype_sheets[a][i] = NULL;
+            anim_frame_width[a][i] = 0.0f;
+        }
+    assets_held = false;
+}
+
+/* Dev-mode hot reload */
+
+void fighter_assets_refresh(FighterStore *store)
+{
+    if (assets_held)
+        for (int a = 0; a < fighter_archetype_count; ++a)
+            for (int i = 0; i < ANIM_COUNT; ++i)
+            {
+                const SpriteSheet *sheet = archetype_sheets[a][i];
+                anim_frame_width[a][i] =
+                    sheet ? (float)sheet->w / (float)fighter_archetypes[a].anims[i].frame_count : 0.0f;
+            }
+    if (!store)
+        return;
+    for (int id = 0; id < store->count; ++id)
+    {
+        int frame_count = fighter_archetypes[store->archetype[id]].anims[store->anim[id]].frame_count;
+        if (store->current_frame[id] >= frame_count)
+            store->current_frame[id] = (Uint8)(frame_count - 1);
+        store->frame_width[id] = anim_frame_width[store->archetype[id]][store->anim[id]];
+    }
+}
+
+bool fighter_defs_reload(SDL_Renderer *renderer, FighterStore *store)
+{
+    static FighterArchetype previous[FIGHTER_MAX_ARCHETYPES];
+    int previous_count = fighter_archetype_count;
+    Uint32 previous_hash = fighter_defs_hash;
+    memcpy(previous, fighter_archetypes, sizeof(previous));
+    if (!fighter_defs_load(FIGHTER_DEFS_PATH))
+        return false;
+
+    if (assets_held)
+    {
+        /* Take the new sheets before dropping the old, so shared ones stay put */
+        SpriteSheet *sheets[FIGHTER_MAX_ARCHETYPES][ANIM_COUNT] = {{NULL}};
+        bool ok = true;
+        for (int a = 0; a < fighter_archetype_count; ++a)
+            for (int i = 0; i < ANIM_COUNT; ++i)
+            {
+                sheets[a][i] = asset_cache_acquire(renderer, fighter_archetypes[a].anims[i].path);
+                if (!sheets[a][i])
+                    ok = false;
+            }
+        if (!ok)
+        {
+            for (int a = 0; a < fighter_archetype_count; ++a)
+                for (int i = 0; i < ANIM_COUNT; ++i)
+                    asset_cache_release(sheets[a][i]);
+            memcpy(fighter_archetypes, previous, sizeof(previous));
+            fighter_archetype_count = previous_count;
+            fighter_defs_hash = previous_hash;
+            fprintf(stderr, "Fighters: new sheets failed to load; keeping the old definitions.\n");
+            return false;
+        }
+        for (int a = 0; a < previous_count; ++a)
+            for (int i = 0; i < ANIM_COUNT; ++i)
+                asset_cache_release(archetype_sheets[a][i]);
+        memcpy(archetype_sheets, sheets, sizeof(sheets));
+    }
+
+    /* Frame counts may have moved under the boxes; a bad file keeps the old ones */
+    if (frame_data_loaded())
+        frame_data_load(FRAME_DATA_PATH);
+    fighter_assets_refresh(store);
+    if (store)
+        for (int id = 0; id < store->count; ++id)
+        {
+            store->ai[id] = fighter_archetypes[store->archetype[id]].ai; /* retune the AI mid-fight */
+            store->command_state[id] = 0;                                  /* the DFA may have changed */
+        }
+    return true;
+}
+
+Uint32 fighter_data_hash(void)
+{
+    return fighter_defs_hash * 16777619u ^ frame_data_hash();
+}
+
+/* ---------- Store ---------- */
+
+static void enter_state(FighterStore *s, int id, FighterState state, Uint32 now)
+{
+    s->state[id] = (Uint8)state;
+    s->current_frame[id] = 0;
+    if (state == FIGHTER_ATTACKING || state == FIGHTER_DOWN_ATTACK)
+        s->flags[id] &= ~FIGHTER_HIT_LANDED; /* a new swing */
+    s->last_frame_time[id] = now;
+    if (state == FIGHTER_BLOCK_HURT)
+        s->block_hurt_start_time[id] = now;
+
+    int anim = state_anim[state];
+    if (state == FIGHTER_ATTACKING)
+        anim += s->current_attack[id];
+    s->anim[id] = (Uint8)anim;
+    s->frame_width[id] = anim_frame_width[s->archetype[id]][anim];
+}
+
+void fighter_store_init(FighterStore *store)
+{
+    memset(store, 0, sizeof(*store));
+}
+
+int fighter_spawn(FighterStore *store, ArchetypeId archetype, FighterController controller,
+                  float x, float y, Uint32 now)
+{
+    if (store->count == MAX_FIGHTERS)
+    {
+        fprintf(stderr, "Fighter store full (%d fighters).\n", MAX_FIGHTERS);
+        return -1;
+    }
+    if (!assets_held)
+    {
+        fprintf(stderr, "Fighter '%s': sprite sheets are not loaded.\n", fighter_archetypes[archetype].name);
+        return -1;
+    }
+    int id = store->count;
+
+    store->x[id] = store->prev_x[id] = x;
+    store->y[id] = store->prev_y[id] = y;
+    store->velocity_x[id] = 0.0f;
+    store->velocity_y[id] = 0.0f;
+    store->direction[id] = FACING_RIGHT;
+    store->flags[id] = 0;
+    store->current_attack[id] = 0;
+    store->input[id] = 0;
+    store->latched[id] = 0;
+    store->attack_start_time[id] = 0;
+    store->block_hurt_start_time[id] = 0;
+    store->hitstop_ms[id] = 0;
+    store->command_state[id] = 0;
+    store->command_time[id] = 0;
+    store->reposition_start_time[id] = 0;
+    store->last_reposition_time[id] = 0;
+    store->reposition_duration[id] = 0;
+    store->archetype[id] = (Uint8)archetype;
+    store->controller[id] = controller;
+    store->ai[id] = fighter_archetypes[archetype].ai;
+    store->count++;
+
+    enter_state(store, id, FIGHTER_IDLE, now);
+    return id;
+}
+
+void fighter_set_state(FighterStore *s, int id, FighterState state, Uint32 now)
+{
+    /* Attacks restart when re-entered; other states just carry on */
+    if (s->state[id] == state && state != FIGHTER_ATTACKING && state != FIGHTER_DOWN_ATTACK)
+        return;
+    enter_state(s, id, state, now);
+}
+
+static void hold(FighterStore *s, int id, Uint32 ms)
+{
+    if (ms > s->hitstop_ms[id])
+        s->hitstop_ms[id] = (Uint16)ms;
+}
+
+void fighter_impact(FighterStore *s, int attacker, int defender, bool blocked)
+{
+    const FighterArchetype *arch = &fighter_archetypes[s->archetype[attacker]];
+    Uint32 ms = blocked ? arch->block_hitstop_ms : arch->hitstop_ms;
+    hold(s, attacker, ms);
+    hold(s, defender, ms);
+}
+
+/* ---------- Controllers ---------- */
+
+FighterInput fighter_read_keys(const FighterKeymap *keys, const Uint8 *keystate)
+{
+    FighterInput in = 0;
+    if (keystate[keys->left])
+        in |= INPUT_LEFT;
+    if (keystate[keys->right])
+        in |= INPUT_RIGHT;
+    if (keystate[keys->jump])
+        in |= INPUT_JUMP;
+    if (keystate[keys->attack])
+        in |= INPUT_ATTACK;
+    if (keystate[keys->down_attack])
+        in |= INPUT_DOWN_ATTACK;
+    if (keystate[keys->block])
+        in |= INPUT_BLOCK;
+    if (keystate[keys->slide] || (keys->slide_alt != SDL_SCANCODE_UNKNOWN && keystate[keys->slide_alt]))
+        in |= INPUT_SLIDE;
+    return in;
+}
+
+/* Forward is toward the nearest other fighter (the facing if alone) */
+static bool forward_is_right(const FighterStore *s, int id)
+{
+    float nearest = -1.0f;
+    bool right = s->direction[id] == FACING_RIGHT;
+    for (int other = 0; other < s->count; ++other)
+    {
+        float dx = s->x[other] - s->x[id];
+        if (other != id && (nearest < 0.0f || fabsf(dx) < nearest))
+        {
+            nearest = fabsf(dx);
+            right = dx > 0.0f;
+        }
+    }
+    return right;
+}
+
+/* Feeds this step's fresh presses to the archetype's command DFA */
+static CommandAction read_commands(FighterStore *s, int id, FighterInput pressed, Uint32 now)
+{
+    const FighterArchetype *arch = &fighter_archetypes[s->archetype[id]];
+    if (!pressed || arch->commands.state_count <= 1)
+        return ACTION_NONE;
+    if (now - s->command_time[id] > arch->command_window_ms)
+        s->command_state[id] = 0; /* too slow: start over */
+    s->command_time[id] = now;
+
+    FighterInput forward = forward_is_right(s, id) ? INPUT_RIGHT : INPUT_LEFT;
+    FighterInput back = forward == INPUT_RIGHT ? INPUT_LEFT : INPUT_RIGHT;
+    const FighterInput by_symbol[SYM_COUNT] = {
+        [SYM_FORWARD] = forward,
+        [SYM_BACK] = back,
+        [SYM_JUMP] = INPUT_JUMP,
+        [SYM_ATTACK] = INPUT_ATTACK,
+        [SYM_DOWN_ATTACK] = INPUT_DOWN_ATTACK,
+        [SYM_BLOCK] = INPUT_BLOCK,
+        [SYM_SLIDE] = INPUT_SLIDE,
+    };
+    CommandAction action = ACTION_NONE;
+    for (int sym = 0; sym < SYM_COUNT; ++sym)
+        if (pressed & by_symbol[sym])
+        {
+            CommandAction done = command_dfa_feed(&arch->commands, &s->command_state[id], (CommandSymbol)sym);
+            if (done != ACTION_NONE)
+                action = done;
+        }
+    return action;
+}
+
+static void start_attack(FighterStore *s, int id, int attack, Uint32 now)
+{
+    s->flags[id] |= FIGHTER_IS_ATTACKING;
+    s->flags[id] &= ~FIGHTER_DASHING;
+    s->attack_start_time[id] = now;
+    s->current_attack[id] = (Uint8)attack;
+    fighter_set_state(s, id, FIGHTER_ATTACKING, now);
+    s->latched[id] |= INPUT_ATTACK;
+}
+
+static void apply_input(FighterStore *s, int id, FighterInput in, Uint32 now)
+{
+    FighterInput pressed = in & ~s->input[id];
+    s->input[id] = in;
+    CommandAction action = read_commands(s, id, pressed, now);
+    if (s->state[id] == FIGHTER_DEATH)
+        return;
+
+    /* While truly hurt, ignore input */
+    if (s->state[id] == FIGHTER_HURT)
+        return;
+
+    const FighterArchetype *arch = &fighter_archetypes[s->archetype[id]];
+    bool on_ground = s->flags[id] & FIGHTER_ON_GROUND;
+
+    /* Reset horizontal velocity each step; states will set as needed */
+    s->velocity_x[id] = 0.0f;
+
+    bool busy_attack = (s->flags[id] & FIGHTER_IS_ATTACKING) &&
+                       (s->state[id] == FIGHTER_ATTACKING || s->state[id] == FIGHTER_DOWN_ATTACK);
+    bool busy_block = (s->flags[id] & FIGHTER_IS_BLOCKING) || s->state[id] == FIGHTER_BLOCKING;
+    bool moving_held = in & (INPUT_LEFT | INPUT_RIGHT);
+    /* Inside the attack's cancel window the next attack may start early */
+    int cancel_frame = arch->anims[s->anim[id]].cancel_frame;
+    bool can_chain = s->state[id] == FIGHTER_ATTACKING && cancel_frame >= 0 && s->current_frame[id] >= cancel_frame;
+
+    /* A command's attack goes off on the move and out of chain order */
+    if (action >= ACTION_ATTACK1 && action <= ACTION_ATTACK3 && (!busy_attack || can_chain) && !busy_block)
+    {
+        start_attack(s, id, action - ACTION_ATTACK1, now);
+        busy_attack = true;
+        can_chain = false;
+    }
+    else if (action == ACTION_DASH && on_ground && !busy_attack && !busy_block)
+    {
+        s->flags[id] |= FIGHTER_DASHING;
+    }
+
+    /* Horizontal movement */
+    if ((in & INPUT_LEFT) && !busy_attack && !busy_block)
+    {
+        s->velocity_x[id] = -arch->speed;
+        s->direction[id] = FACING_LEFT;
+        if (on_ground && s->state[id] != FIGHTER_SLIDE)
+            fighter_set_state(s, id, FIGHTER_WALKING, now);
+    }
+    else if ((in & INPUT_RIGHT) && !busy_attack && !busy_block)
+    {
+        s->velocity_x[id] = arch->speed;
+        s->direction[id] = FACING_RIGHT;
+        if (on_ground && s->state[id] != FIGHTER_SLIDE)
+            fighter_set_state(s, id, FIGHTER_WALKING, now);
+    }
+    else if (s->state[id] == FIGHTER_WALKING && on_ground)
+    {
+        fighter_set_state(s, id, FIGHTER_IDLE, now);
+    }
+
+    if ((in & INPUT_JUMP) && on_ground && !busy_attack && !busy_block)
+    {
+        s->velocity_y[id] = arch->jump_force;
+        s->flags[id] &= ~(FIGHTER_ON_GROUND | FIGHTER_DASHING);
+        on_ground = false;
+        fighter_set_state(s, id, FIGHTER_JUMPING, now);
+    }
+
+    /* Attack (ground or air), only while not moving. The latch drops
+     * whenever an attack is not possible, so a held button attacks again
+     * as soon as the previous one ends or can be cancelled. */
+    if (!moving_held && (in & INPUT_ATTACK) && (!busy_attack || can_chain) && !busy_block)
+    {
+        if (!(s->latched[id] & INPUT_ATTACK))
+            start_attack(s, id, (s->current_attack[id] + 1) % 3, now);
+    }
+    else
+    {
+        s->latched[id] &= ~INPUT_ATTACK;
+    }
+
+    /* Aerial straight-down attack */
+    if ((in & INPUT_DOWN_ATTACK) && !busy_attack && !busy_block && !on_ground)
+    {
+        if (!(s->latched[id] & INPUT_DOWN_ATTACK))
+        {
+            s->flags[id] |= FIGHTER_IS_ATTACKING;
+            s->attack_start_time[id] = now;
+            fighter_set_state(s, id, FIGHTER_DOWN_ATTACK, now);
+            if (s->velocity_y[id] < DOWN_ATTACK_MIN_FALL)
+                s->velocity_y[id] = DOWN_ATTACK_MIN_FALL;
+            s->latched[id] |= INPUT_DOWN_ATTACK;
+        }
+    }
+    else
+    {
+        s->latched[id] &= ~INPUT_DOWN_ATTACK;
+    }
+
+    /* Block while held, only while not moving; works in the air as well */
+    if (!moving_held && (in & INPUT_BLOCK) && !busy_attack)
+    {
+        if (!(s->flags[id] & FIGHTER_IS_BLOCKING))
+        {
+            s->flags[id] |= FIGHTER_IS_BLOCKING;
+            fighter_set_state(s, id, FIGHTER_BLOCKING, now);
+        }
+    }
+    else if (s->flags[id] & FIGHTER_IS_BLOCKING)
+    {
+        s->flags[id] &= ~FIGHTER_IS_BLOCKING;
+        fighter_set_state(s, id, on_ground ? FIGHTER_IDLE : FIGHTER_JUMPING, now);
+    }
+
+    /* Slide (ground only); a dash slides while its direction stays held */
+    bool dashing = (s->flags[id] & FIGHTER_DASHING) &&
+                   (in & (s->direction[id] == FACING_RIGHT ? INPUT_RIGHT : INPUT_LEFT));
+    if (!dashing)
+        s->flags[id] &= ~FIGHTER_DASHING;
+    if (((in & INPUT_SLIDE) || dashing) && on_ground && !busy_attack && !busy_block)
+    {
+        if (s->state[id] != FIGHTER_SLIDE)
+            fighter_set_state(s, id, FIGHTER_SLIDE, now);
+        s->velocity_x[id] = (s->direction[id] == FACING_RIGHT ? arch->speed : -arch->speed) * SLIDE_SPEED_SCALE;
+    }
+    else if (s->state[id] == FIGHTER_SLIDE && on_ground)
+    {
+        fighter_set_state(s, id, FIGHTER_IDLE, now);
+    }
+
+    /* Keep the in-air animation, but don't override aerial attack/block/hurt */
+    if (!on_ground &&
+        s->state[id] != FIGHTER_JUMPING &&
+        s->state[id] != FIGHTER_DOWN_ATTACK &&
+        s->state[id] != FIGHTER_HURT &&
+        s->state[id] != FIGHTER_ATTACKING &&
+        s->state[id] != FIGHTER_BLOCKING)
+    {
+        fighter_set_state(s, id, FIGHTER_JUMPING, now);
+    }
+}
+
+static void control_ai(FighterStore *s, int id, SimRng *rng, Uint32 now)
+{
+    const FighterArchetype *arch = &fighter_archetypes[s->archetype[id]];
+    const AiTuning *ai = &s->ai[id];
+    int target = s->controller[id].target;
+    float speed = arch->speed;
+
+    if (target < 0 || target >= s->count ||
+        s->state[id] == FIGHTER_HURT || s->state[id] == FIGHTER_DEATH)
+    {
+        s->velocity_x[id] = 0;
+        return;
+    }
+    if (s->state[target] == FIGHTER_DEATH)
+    {
+        s->velocity_x[id] = 0;
+        fighter_set_state(s, id, FIGHTER_IDLE, now);
+        return;
+    }
+
+    /* Senses */
+    float distance_x = s->x[target] - s->x[id];
+    float abs_distance = fabsf(distance_x);
+    s->direction[id] = (distance_x > 0) ? FACING_RIGHT : FACING_LEFT;
+    bool target_facing_us = (s->direction[target] == FACING_RIGHT && distance_x < 0) ||
+                            (s->direction[target] == FACING_LEFT && distance_x > 0);
+
+    /* Priority 1: ongoing timed actions */
+    if (s->flags[id] & FIGHTER_IS_ATTACKING)
+    {
+        if (now - s->attack_start_time[id] < arch->attack_duration)
+        {
+            s->velocity_x[id] = 0;
+            return;
+        }
+        s->flags[id] &= ~FIGHTER_IS_ATTACKING;
+    }
+
+    if (s->state[id] == FIGHTER_REPOSITIONING)
+    {
+        if (now - s->reposition_start_time[id] < s->reposition_duration[id])
+        {
+            s->velocity_x[id] = (s->direction[id] == FACING_RIGHT ? -speed : speed) * ai->reposition_speed;
+            return;
+        }
+        fighter_set_state(s, id, FIGHTER_IDLE, now);
+        s->velocity_x[id] = 0;
+        return;
+    }
+
+    /* Priority 2: defend */
+    if ((s->flags[target] & FIGHTER_IS_ATTACKING) && target_facing_us && abs_distance < ai->block_range)
+    {
+        s->velocity_x[id] = 0;
+        fighter_set_state(s, id, FIGHTER_BLOCKING, now);
+        return;
+    }
+
+    /* Priority 3: attack */
+    bool target_vulnerable = !(s->flags[target] & FIGHTER_IS_BLOCKING) || !target_facing_us;
+    if (abs_distance <= ai->attack_range && target_vulnerable)
+    {
+        s->velocity_x[id] = 0;
+        s->flags[id] |= FIGHTER_IS_ATTACKING;
+        s->current_attack[id] = (Uint8)sim_rng_range(rng, 0, 2);
+        s->attack_start_time[id] = now;
+        fighter_set_state(s, id, FIGHTER_ATTACKING, now);
+        return;
+    }
+
+    /* Priority 4: back off when crowded, if the cooldown allows */
+    Uint32 cooldown = sim_rng_range(rng, ai->cooldown_min_ms, ai->cooldown_max_ms);
+    if (abs_distance < ai->reposition_trigger && now - s->last_reposition_time[id] > cooldown)
+    {
+        s->reposition_start_time[id] = now;
+        s->last_reposition_time[id] = now;
+        s->reposition_duration[id] = sim_rng_range(rng, ai->reposition_min_ms, ai->reposition_max_ms);
+        fighter_set_state(s, id, FIGHTER_REPOSITIONING, now);
+        return;
+    }
+
+    /* Priority 5: chase; in range but unable to attack (target blocking), wait */
+    if (abs_distance > ai->attack_range)
+    {
+        s->velocity_x[id] = (s->direction[id] == FACING_RIGHT) ? speed : -speed;
+        fighter_set_state(s, id, FIGHTER_WALKING, now);
+    }
+    else
+    {
+        s->velocity_x[id] = 0;
+        fighter_set_state(s, id, FIGHTER_IDLE, now);
+    }
+}
+
+void fighter_store_control(FighterStore *store, const FighterInput inputs[MAX_FIGHTERS], SimRng *rng, Uint32 now)
+{
+    for (int id = 0; id < store->count; ++id)
+    {
+        if (store->hitstop_ms[id] > 0)
+            continue; /* frozen; a button held through it counts once it ends */
+        switch (store->controller[id].kind)
+        {
+        case CONTROL_PLAYER:
+            apply_input(store, id, inputs[id], now);
+            break;
+        case CONTROL_AI:
+            control_ai(store, id, rng, now);
+            break;
+        }
+    }
+}
+
+/* ---------- Simulation ---------- */
+
+void fighter_store_update(FighterStore *s, const GameClock *clock)
+{
+    Uint32 now = clock->now;
+    float dt = clock->delta_ms / 1000.0f;
+
+    for (int id = 0; id < s->count; ++id)
+    {
+        const FighterArchetype *arch = &fighter_archetypes[s->archetype[id]];
+
+        /* Remember where this step started so rendering can interpolate */
+        s->prev_x[id] = s->x[id];
+        s->prev_y[id] = s->y[id];
+
+        /* Hitstop: the step passes this fighter by, so every "since" timer
+         * moves up with the clock */
+        s->flags[id] &= ~FIGHTER_FROZEN;
+        if (s->hitstop_ms[id] > 0)
+        {
+            Uint32 held = clock->delta_ms;
+            s->hitstop_ms[id] = (Uint16)(s->hitstop_ms[id] > held ? s->hitstop_ms[id] - held : 0);
+            s->last_frame_time[id] += held;
+            s->attack_start_time[id] += held;
+            s->block_hurt_start_time[id] += held;
+            s->reposition_start_time[id] += held;
+            s->last_reposition_time[id] += held;
+            s->command_time[id] += held;
+            s->flags[id] |= FIGHTER_FROZEN;
+            continue;
+        }
+
+        s->x[id] += s->velocity_x[id] * dt;
+        s->y[id] += s->velocity_y[id] * dt;
+        if (!(s->flags[id] & FIGHTER_ON_GROUND))
+            s->velocity_y[id] += arch->gravity * dt;
+
+        if (s->y[id] >= FIGHTER_GROUND_LEVEL)
+        {
+            s->y[id] = FIGHTER_GROUND_LEVEL;
+            s->velocity_y[id] = 0;
+            if (!(s->flags[id] & FIGHTER_ON_GROUND))
+            {
+                s->flags[id] |= FIGHTER_ON_GROUND;
+                if (s->state[id] == FIGHTER_JUMPING || s->state[id] == FIGHTER_DOWN_ATTACK)
+                    fighter_set_state(s, id, FIGHTER_IDLE, now);
+            }
+        }
+        else
+            s->flags[id] &= ~FIGHTER_ON_GROUND;
+
+        bool on_ground = s->flags[id] & FIGHTER_ON_GROUND;
+
+        /* Attack timer; leaves any state the attack was interrupted by alone */
+        if ((s->flags[id] & FIGHTER_IS_ATTACKING) && now - s->attack_start_time[id] >= arch->attack_duration)
+        {
+            s->flags[id] &= ~FIGHTER_IS_ATTACKING;
+            if (s->state[id] == FIGHTER_ATTACKING || s->state[id] == FIGHTER_DOWN_ATTACK)
+                fighter_set_state(s, id, on_ground ? FIGHTER_IDLE : FIGHTER_JUMPING, now);
+        }
+
+        /* Block-hurt timer (independent of real hurt) */
+        if (s->state[id] == FIGHTER_BLOCK_HURT && now - s->block_hurt_start_time[id] >= arch->block_hurt_duration)
+            fighter_set_state(s, id, on_ground ? FIGHTER_IDLE : FIGHTER_JUMPING, now);
+
+        /* Animation: the definition says whether it loops, holds its last
+         * frame (attacks, death) or goes idle after one pass (pray) */
+        const AnimDef *anim = &arch->anims[s->anim[id]];
+        if (now - s->last_frame_time[id] >= anim->frame_delay)
+        {
+            int last = anim->frame_count - 1;
+            if (anim->loop == ANIM_LOOP)
+                s->current_frame[id] = (Uint8)((s->current_frame[id] + 1) % anim->frame_count);
+            else if (s->current_frame[id] < last)
+                s->current_frame[id]++;
+            s->last_frame_time[id] = now;
+            if (anim->loop == ANIM_ONCE && s->current_frame[id] >= last)
+                fighter_set_state(s, id, FIGHTER_IDLE, now);
+        }
+
+        if (s->x[id] < -STAGE_MARGIN)
+            s->x[id] = -STAGE_MARGIN;
+        if (s->x[id] > STAGE_WIDTH + STAGE_MARGIN - s->frame_width[id])
+            s->x[id] = STAGE_WIDTH + STAGE_MARGIN - s->frame_width[id];
+    }
+}
+
+void fighter_store_render(SDL_Renderer *renderer, const FighterStore *s, float alpha)
+{
+    if (!renderer)
+        return;
+
+    for (int id = 0; id < s->count; ++id)
+    {
+        const SpriteSheet *sheet = archetype_sheets[s->archetype[id]][s->anim[id]];
+        if (!sheet || !sheet->texture)
+            continue;
+
+        /* Blend between the previous and current sim positions (whole pixels) */
+        SDL_FRect dest = {
+            (float)(int)(s->prev_x[id] + (s->x[id] - s->prev_x[id]) * alpha),
+            (float)(int)(s->prev_y[id] + (s->y[id] - s->prev_y[id]) * alpha),
+            (float)(int)s->frame_width[id], FIGHTER_HEIGHT};
+
+        /* Frame rect in texture space (the sheet may sit inside an atlas page) */
+        SDL_Rect src = sprite_sheet_frame(sheet, s->current_frame[id],
+                                          fighter_archetypes[s->archetype[id]].anims[s->anim[id]].frame_count);
+
+        SDL_RendererFlip flip = (s->direction[id] == FACING_LEFT) ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE;
+        sprite_batch_sprite(renderer, sheet->texture, &src, &dest, flip, (SDL_Color){255, 255, 255, 255});
+    }
+}
@@ -0,0 +1,365 @@
+#include "fighter.h"
+#include "asset_pack.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+FighterArchetype fighter_archetypes[FIGHTER_MAX_ARCHETYPES];
+int fighter_archetype_count = 0;
+Uint32 fighter_defs_hash = 0;
+
+#define DEFAULT_COMMAND_WINDOW_MS 200
+
+const AiTuning fighter_ai_defaults = {
+    .attack_range = 200,
+    .block_range = 250,
+    .reposition_trigger = 550,
+    .reposition_speed = 0.7f,
+    .reposition_min_ms = 400,
+    .reposition_max_ms = 700,
+    .cooldown_min_ms = 2500,
+    .cooldown_max_ms = 4000,
+};
+
+/* Names used in the data files, by AnimId */
+static const char *const anim_names[ANIM_COUNT] = {
+    [ANIM_IDLE] = "idle",
+    [ANIM_WALK] = "walk",
+    [ANIM_JUMP] = "jump",
+    [ANIM_ATTACK1] = "attack1",
+    [ANIM_ATTACK2] = "attack2",
+    [ANIM_ATTACK3] = "attack3",
+    [ANIM_BLOCK] = "block",
+    [ANIM_HURT] = "hurt",
+    [ANIM_DEATH] = "death",
+    [ANIM_SLIDE] = "slide",
+    [ANIM_BLOCK_HURT] = "block_hurt",
+    [ANIM_PRAY] = "pray",
+    [ANIM_DOWN_ATTACK] = "down_attack",
+    [ANIM_REPOSITION] = "reposition",
+};
+
+static const char *const loop_names[] = {
+    [ANIM_LOOP] = "loop",
+    [ANIM_HOLD] = "hold",
+    [ANIM_ONCE] = "once",
+};
+
+/* The game refers to these by ArchetypeId; they always come first */
+static const char *const builtin_names[] = {
+    [ARCHETYPE_PLAYER] = "player",
+    [ARCHETYPE_ENEMY] = "enemy",
+};
+#define BUILTIN_COUNT ((int)(sizeof(builtin_names) / sizeof(builtin_names[0])))
+
+static int find_name(const char *name, const char *const *names, int count)
+{
+    for (int i = 0; i < count; ++i)
+        if (names[i] && strcmp(names[i], name) == 0)
+            return i;
+    return -1;
+}
+
+int fighter_anim_find(const char *name)
+{
+    return find_name(name, anim_names, ANIM_COUNT);
+}
+
+const char *fighter_anim_name(AnimId anim)
+{
+    return anim < ANIM_COUNT ? anim_names[anim] : "?";
+}
+
+int fighter_archetype_find(const char *name)
+{
+    for (int a = 0; a < fighter_archetype_count; ++a)
+        if (strcmp(fighter_archetypes[a].name, name) == 0)
+            return a;
+    return -1;
+}
+
+bool fighter_defs_loaded(void)
+{
+    return fighter_archetype_count > 0;
+}
+
+bool fighter_ai_set(AiTuning *ai, const char *key, double value)
+{
+    if (value < 0)
+        return false;
+    bool fits_ms = value <= 65535;
+    if (strcmp(key, "ai_attack_range") == 0)
+        ai->attack_range = (float)value;
+    else if (strcmp(key, "ai_block_range") == 0)
+        ai->block_range = (float)value;
+    else if (strcmp(key, "ai_reposition_trigger") == 0)
+        ai->reposition_trigger = (float)value;
+    else if (strcmp(key, "ai_reposition_speed") == 0)
+        ai->reposition_speed = (float)value;
+    else if (strcmp(key, "ai_reposition_min_ms") == 0 && fits_ms)
+        ai->reposition_min_ms = (Uint16)value;
+    else if (strcmp(key, "ai_reposition_max_ms") == 0 && fits_ms)
+        ai->reposition_max_ms = (Uint16)value;
+    else if (strcmp(key, "ai_cooldown_min_ms") == 0 && fits_ms)
+        ai->cooldown_min_ms = (Uint16)value;
+    else if (strcmp(key, "ai_cooldown_max_ms") == 0 && fits_ms)
+        ai->cooldown_max_ms = (Uint16)value;
+    else
+        return false;
+    return true;
+}
+
+bool fighter_ai_valid(const AiTuning *ai)
+{
+    return ai->reposition_min_ms <= ai->reposition_max_ms && ai->cooldown_min_ms <= ai->cooldown_max_ms;
+}
+
+/* Fighter-level settings: "<key> <number>" */
+static bool parse_setting(FighterArchetype *arch, const char *key, const char *value)
+{
+    char *end;
+    double v = strtod(value, &end);
+    if (end == value || *end != '\0')
+        return false;
+
+    if (strcmp(key, "speed") == 0)
+        arch->speed = (float)v;
+    else if (strcmp(key, "jump_force") == 0)
+        arch->jump_force = (float)v;
+    else if (strcmp(key, "gravity") == 0)
+        arch->gravity = (float)v;
+    else if (strcmp(key, "attack_duration") == 0 && v >= 0)
+        arch->attack_duration = (Uint32)v;
+    else if (strcmp(key, "block_hurt_duration") == 0 && v >= 0)
+        arch->block_hurt_duration = (Uint32)v;
+    else if (strcmp(key, "hitstop_ms") == 0 && v >= 0 && v <= 65535)
+        arch->hitstop_ms = (Uint32)v;
+    else if (strcmp(key, "block_hitstop_ms") == 0 && v >= 0 && v <= 65535)
+        arch->block_hitstop_ms = (Uint32)v;
+    else if (strcmp(key, "command_window_ms") == 0 && v >= 0)
+        arch->command_window_ms = (Uint32)v;
+    else
+        return fighter_ai_set(&arch->ai, key, v);
+    return true;
+}
+
+/* "anim <name> <frames> <ms> <loop|hold|once> <cancel frame|-> <sheet>" */
+static bool parse_anim(FighterArchetype *arch, Uint32 *defined, const char *line, const char *path, int line_no)
+{
+    char name[32], mode[16], cancel[16], sheet[FIGHTER_PATH_MAX + 1], extra;
+    int frames;
+    unsigned delay;
+    if (sscanf(line, " anim %31s %d %u %15s %15s %96s %c", name, &frames, &delay, mode, cancel, sheet, &extra) != 6)
+    {
+        fprintf(stderr, "Fighter defs %s:%d: expected 'anim <name> <frames> <ms> <loop|hold|once> <cancel|-> <sheet>'.\n",
+                path, line_no);
+        return false;
+    }
+
+    int anim = fighter_anim_find(name);
+    int loop = find_name(mode, loop_names, (int)(sizeof(loop_names) / sizeof(loop_names[0])));
+    int cancel_frame = -1;
+    if (strcmp(cancel, "-") != 0)
+    {
+        char *end;
+        cancel_frame = (int)strtol(cancel, &end, 10);
+        if (end == cancel || *end != '\0' || cancel_frame < 0 || cancel_frame >= frames)
+            cancel_frame = -2;
+    }
+    if (anim < 0 || loop < 0 || frames < 1 || frames > FIGHTER_MAX_FRAMES || delay == 0 || cancel_frame == -2 ||
+        strlen(sheet) >= FIGHTER_PATH_MAX)
+    {
+        fprintf(stderr, "Fighter defs %s:%d: bad animation name, frame count (1-%d), delay, mode, cancel frame or path.\n",
+                path, line_no, FIGHTER_MAX_FRAMES);
+        return false;
+    }
+
+    AnimDef *def = &arch->anims[anim];
+    strcpy(def->path, sheet);
+    def->frame_count = frames;
+    def->frame_delay = delay;
+    def->loop = (Uint8)loop;
+    def->cancel_frame = (Sint8)cancel_frame;
+    *defined |= 1u << anim;
+    return true;
+}
+
+/* "command <action> <press> <press>..." */
+static bool parse_command(Command *command, char *line, const char *path, int line_no)
+{
+    memset(command, 0, sizeof(*command));
+    strtok(line, " \t\r"); /* "command" */
+    const char *action = strtok(NULL, " \t\r");
+    int found = action ? command_action_find(action) : -1;
+    if (found <= ACTION_NONE)
+    {
+        fprintf(stderr, "Fighter defs %s:%d: expected 'command <dash|attack1|attack2|attack3> <presses>'.\n",
+                path, line_no);
+        return false;
+    }
+    command->action = (Uint8)found;
+
+    for (const char *press; (press = strtok(NULL, " \t\r")) != NULL;)
+    {
+        int symbol = command_symbol_find(press);
+        if (symbol < 0 || command->length == COMMAND_MAX_STEPS)
+        {
+            fprintf(stderr, "Fighter defs %s:%d: unknown press '%s' or more than %d of them.\n",
+                    path, line_no, press, COMMAND_MAX_STEPS);
+            return false;
+        }
+        command->steps[command->length++] = (Uint8)symbol;
+    }
+    if (command->length == 0)
+    {
+        fprintf(stderr, "Fighter defs %s:%d: a command needs at least one press.\n", path, line_no);
+        return false;
+    }
+    return true;
+}
+
+static bool parse_defs(char *text, const char *path, FighterArchetype *out, int *out_count)
+{
+    FighterArchetype parsed[FIGHTER_MAX_ARCHETYPES];
+    Uint32 defined[FIGHTER_MAX_ARCHETYPES] = {0};
+    Command commands[FIGHTER_MAX_ARCHETYPES][COMMAND_MAX];
+    int command_count[FIGHTER_MAX_ARCHETYPES] = {0};
+    int count = 0;
+    memset(parsed, 0, sizeof(parsed));
+
+    int line_no = 0;
+    for (char *line = text; line;)
+    {
+        char *next = strchr(line, '\n');
+        if (next)
+            *next++ = '\0';
+        line_no++;
+
+        char *comment = strchr(line, '#');
+        if (comment)
+            *comment = '\0';
+
+        char key[32], value[FIGHTER_NAME_MAX + 1], extra;
+        int fields = sscanf(line, "%31s %32s %c", key, value, &extra);
+        if (fields <= 0)
+        {
+            line = next;
+            continue;
+        }
+
+        if (strcmp(key, "fighter") == 0)
+        {
+            if (fields != 2 || strlen(value) >= FIGHTER_NAME_MAX)
+            {
+                fprintf(stderr, "Fighter defs %s:%d: expected 'fighter <name>'.\n", path, line_no);
+                return false;
+            }
+            if (count == FIGHTER_MAX_ARCHETYPES)
+            {
+                fprintf(stderr, "Fighter defs %s:%d: more than %d fighters.\n", path, line_no, FIGHTER_MAX_ARCHETYPES);
+                return false;
+            }
+            for (int a = 0; a < count; ++a)
+                if (strcmp(parsed[a].name, value) == 0)
+                {
+                    fprintf(stderr, "Fighter defs %s:%d: '%s' is defined twice.\n", path, line_no, value);
+                    return false;
+                }
+            strcpy(parsed[count].name, value);
+            parsed[count].ai = fighter_ai_defaults;
+            parsed[count++].command_window_ms = DEFAULT_COMMAND_WINDOW_MS;
+        }
+        else if (count == 0)
+        {
+            fprintf(stderr, "Fighter defs %s:%d: settings before the first 'fighter'.\n", path, line_no);
+            return false;
+        }
+        else if (strcmp(key, "anim") == 0)
+        {
+            if (!parse_anim(&parsed[count - 1], &defined[count - 1], line, path, line_no))
+                return false;
+        }
+        else if (strcmp(key, "command") == 0)
+        {
+            int a = count - 1;
+            if (command_count[a] == COMMAND_MAX)
+            {
+                fprintf(stderr, "Fighter defs %s:%d: more than %d commands.\n", path, line_no, COMMAND_MAX);
+                return false;
+            }
+            if (!parse_command(&commands[a][command_count[a]++], line, path, line_no))
+                return false;
+        }
+        else if (fields != 2 || !parse_setting(&parsed[count - 1], key, value))
+        {
+            fprintf(stderr, "Fighter defs %s:%d: unknown setting or bad value '%s'.\n", path, line_no, key);
+            return false;
+        }
+        line = next;
+    }
+
+    for (int a = 0; a < count; ++a)
+    {
+        if (!fighter_ai_valid(&parsed[a].ai))
+        {
+            fprintf(stderr, "Fighter defs %s: '%s' has an ai_*_min_ms above its max.\n", path, parsed[a].name);
+            return false;
+        }
+        for (int i = 0; i < ANIM_COUNT; ++i)
+            if (!(defined[a] & (1u << i)))
+            {
+                fprintf(stderr, "Fighter defs %s: '%s' has no '%s' animation.\n", path, parsed[a].name, anim_names[i]);
+                return false;
+            }
+        command_dfa_build(&parsed[a].commands, commands[a], command_count[a]);
+    }
+
+    /* Built-ins at their ArchetypeId, the rest after them in file order */
+    int placed = 0;
+    for (int b = 0; b < BUILTIN_COUNT; ++b)
+    {
+        int a = -1;
+        for (int i = 0; i < count && a < 0; ++i)
+            if (strcmp(parsed[i].name, builtin_names[b]) == 0)
+                a = i;
+        if (a < 0)
+        {
+            fprintf(stderr, "Fighter defs %s: no '%s' fighter.\n", path, builtin_names[b]);
+            return false;
+        }
+        out[placed++] = parsed[a];
+    }
+    for (int i = 0; i < count; ++i)
+        if (find_name(parsed[i].name, builtin_names, BUILTIN_COUNT) < 0)
+            out[placed++] = parsed[i];
+    *out_count = placed;
+    return true;
+}
+
+bool fighter_defs_load(const char *path)
+{
+    /* NUL terminated by SDL */
+    size_t size;
+    char *text = SDL_LoadFile_RW(asset_pack_rw(path), &size, 1);
+    if (!text)
+    {
+        fprintf(stderr, "Fighter defs: can't read %s: %s\n", path, SDL_GetError());
+        return false;
+    }
+
+    /* FNV-1a of the text, before parsing writes into it */
+    Uint32 hash = 2166136261u;
+    for (size_t i = 0; i < size; ++i)
+        hash = (hash ^ (Uint8)text[i]) * 16777619u;
+
+    static FighterArchetype parsed[FIGHTER_MAX_ARCHETYPES];
+    int count = 0;
+    bool ok = parse_defs(text, path, parsed, &count);
+    SDL_free(text);
+    if (!ok)
+        return false;
+    memcpy(fighter_archetypes, parsed, sizeof(fighter_archetypes));
+    fighter_archetype_count = count;
+    fighter_defs_hash = hash;
+    return true;
+}
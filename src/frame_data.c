@@ -0,0 +1,276 @@
+#include "frame_data.h"
+#include "asset_pack.h"
+#include "sprite_batch.h"
+#include <stdio.h>
+#include <string.h>
+
+/* Empty lanes are zero-sized boxes far off stage (mirrored, still off
+ * stage), so the overlap test needs no lane count */
+#define BOX_NOWHERE -1.0e6f
+
+static FrameData frame_table[FIGHTER_MAX_ARCHETYPES][ANIM_COUNT][FIGHTER_MAX_FRAMES];
+static bool table_loaded = false;
+static Uint32 table_hash = 0;
+
+static void clear_boxes(FrameBoxes *b)
+{
+    for (int i = 0; i < FRAME_BOX_LANES; ++i)
+        b->x0[i] = b->y0[i] = b->x1[i] = b->y1[i] = BOX_NOWHERE;
+}
+
+/* "*", "n" or "a-b" */
+static bool parse_frames(const char *text, int *first, int *last)
+{
+    if (strcmp(text, "*") == 0)
+    {
+        *first = 0;
+        *last = FIGHTER_MAX_FRAMES - 1;
+        return true;
+    }
+    char tail;
+    if (sscanf(text, "%d-%d%c", first, last, &tail) == 2)
+        return *first >= 0 && *first <= *last;
+    if (sscanf(text, "%d%c", first, &tail) == 1)
+    {
+        *last = *first;
+        return *first >= 0;
+    }
+    return false;
+}
+
+static bool add_box(FrameBoxes *boxes, Uint8 *count, float x, float y, float w, float h)
+{
+    if (*count == FRAME_BOX_LANES)
+        return false;
+    boxes->x0[*count] = x;
+    boxes->y0[*count] = y;
+    boxes->x1[*count] = x + w;
+    boxes->y1[*count] = y + h;
+    (*count)++;
+    return true;
+}
+
+/* Parses `text` (NUL terminated, modified in place) into `table` */
+static bool parse_table(char *text, const char *path, FrameData (*table)[ANIM_COUNT][FIGHTER_MAX_FRAMES])
+{
+    for (int a = 0; a < FIGHTER_MAX_ARCHETYPES; ++a)
+        for (int i = 0; i < ANIM_COUNT; ++i)
+            for (int f = 0; f < FIGHTER_MAX_FRAMES; ++f)
+            {
+                FrameData *d = &table[a][i][f];
+                clear_boxes(&d->hurt);
+                clear_boxes(&d->hit);
+                d->hurt_count = d->hit_count = 0;
+                d->phase = PHASE_NONE;
+            }
+
+    int line_no = 0;
+    for (char *line = text; line; )
+    {
+        char *next = strchr(line, '\n');
+        if (next)
+            *next++ = '\0';
+        line_no++;
+
+        char *comment = strchr(line, '#');
+        if (comment)
+            *comment = '\0';
+
+        char who[32], anim[32], frames[16], kind[8], extra;
+        float x, y, w, h;
+        int fields = sscanf(line, "%31s %31s %15s %7s %f %f %f %f %c", who, anim, frames, kind, &x, &y, &w, &h, &extra);
+        if (fields <= 0)
+        {
+            line = next;
+            continue;
+        }
+        if (fields != 8 || w <= 0.0f || h <= 0.0f)
+        {
+            fprintf(stderr, "Frame data %s:%d: expected '<archetype|*> <anim> <frames> <hurt|hit> x y w h'.\n", path,
+                    line_no);
+            return false;
+        }
+
+        int archetype = strcmp(who, "*") == 0 ? -1 : fighter_archetype_find(who);
+        int anim_id = fighter_anim_find(anim);
+        int first, last;
+        bool hit = strcmp(kind, "hit") == 0;
+        if ((archetype < 0 && strcmp(who, "*") != 0) || anim_id < 0 || !parse_frames(frames, &first, &last) ||
+            (!hit && strcmp(kind, "hurt") != 0))
+        {
+            fprintf(stderr, "Frame data %s:%d: unknown archetype, animation, frame range or box kind.\n", path,
+                    line_no);
+            return false;
+        }
+
+        for (int a = 0; a < fighter_archetype_count; ++a)
+        {
+            if (archetype >= 0 && a != archetype)
+                continue;
+            /* Frames past this archetype's count are ignored */
+            int frame_count = fighter_archetypes[a].anims[anim_id].frame_count;
+            for (int f = first; f <= last && f < frame_count; ++f)
+            {
+                FrameData *d = &table[a][anim_id][f];
+                bool added = hit ? add_box(&d->hit, &d->hit_count, x, y, w, h)
+                                 : add_box(&d->hurt, &d->hurt_count, x, y, w, h);
+                if (!added)
+                {
+                    fprintf(stderr, "Frame data %s:%d: more than %d %s boxes on frame %d.\n", path, line_no,
+                            FRAME_BOX_LANES, kind, f);
+                    return false;
+                }
+            }
+        }
+        line = next;
+    }
+
+    /* Startup / active / recovery windows from where the hit boxes are */
+    for (int a = 0; a < fighter_archetype_count; ++a)
+        for (int i = 0; i < ANIM_COUNT; ++i)
+        {
+            int frame_count = fighter_archetypes[a].anims[i].frame_count;
+            int first_hit = -1;
+            for (int f = 0; f < frame_count && first_hit < 0; ++f)
+                if (table[a][i][f].hit_count > 0)
+                    first_hit = f;
+            if (first_hit < 0)
+                continue;
+            for (int f = 0; f < frame_count; ++f)
+            {
+                FrameData *d = &table[a][i][f];
+                d->phase = d->hit_count > 0 ? PHASE_ACTIVE : f < first_hit ? PHASE_STARTUP : PHASE_RECOVERY;
+            }
+        }
+    return true;
+}
+
+bool frame_data_load(const char *path)
+{
+    /* NUL terminated by SDL */
+    size_t size;
+    char *text = SDL_LoadFile_RW(asset_pack_rw(path), &size, 1);
+    if (!text)
+    {
+        fprintf(stderr, "Frame data: can't read %s: %s\n", path, SDL_GetError());
+        return false;
+    }
+
+    /* FNV-1a of the text, before parsing writes into it */
+    Uint32 hash = 2166136261u;
+    for (size_t i = 0; i < size; ++i)
+        hash = (hash ^ (Uint8)text[i]) * 16777619u;
+
+    /* Parse into a scratch table so a bad file leaves the current one alone */
+    static FrameData parsed[FIGHTER_MAX_ARCHETYPES][ANIM_COUNT][FIGHTER_MAX_FRAMES];
+    bool ok = parse_table(text, path, parsed);
+    SDL_free(text);
+    if (!ok)
+        return false;
+    memcpy(frame_table, parsed, sizeof(frame_table));
+    table_loaded = true;
+    table_hash = hash;
+    return true;
+}
+
+bool frame_data_loaded(void)
+{
+    return table_loaded;
+}
+
+Uint32 frame_data_hash(void)
+{
+    return table_hash;
+}
+
+const FrameData *frame_data_get(ArchetypeId archetype, AnimId anim, int frame)
+{
+    int last = fighter_archetypes[archetype].anims[anim].frame_count - 1;
+    if (frame > last)
+        frame = last;
+    if (frame < 0)
+        frame = 0;
+    return &frame_table[archetype][anim][frame];
+}
+
+static const FrameData *fighter_frame(const FighterStore *s, int id)
+{
+    return frame_data_get((ArchetypeId)s->archetype[id], (AnimId)s->anim[id], s->current_frame[id]);
+}
+
+FramePhase fighter_frame_phase(const FighterStore *s, int id)
+{
+    return (FramePhase)fighter_frame(s, id)->phase;
+}
+
+/* Frame boxes to stage coordinates for fighter `id`. Written as straight
+ * lane loops with selects rather than branches so they vectorise. */
+static void place_boxes(const FrameBoxes *in, const FighterStore *s, int id, FrameBoxes *out)
+{
+    float x = s->x[id], y = s->y[id], w = s->frame_width[id];
+    float mirror = s->direction[id] == FACING_LEFT ? 1.0f : 0.0f;
+    for (int i = 0; i < FRAME_BOX_LANES; ++i)
+    {
+        /* Facing left: [x0, x1] becomes [w - x1, w - x0] */
+        float left = in->x0[i] + mirror * (w - in->x1[i] - in->x0[i]);
+        float right = in->x1[i] + mirror * (w - in->x0[i] - in->x1[i]);
+        out->x0[i] = x + left;
+        out->x1[i] = x + right;
+        out->y0[i] = y + in->y0[i];
+        out->y1[i] = y + in->y1[i];
+    }
+}
+
+bool frame_data_hits(const FighterStore *s, int attacker, int defender)
+{
+    const FrameData *attack = fighter_frame(s, attacker);
+    if (attack->phase != PHASE_ACTIVE)
+        return false;
+    const FrameData *body = fighter_frame(s, defender);
+
+    FrameBoxes hit, hurt;
+    place_boxes(&attack->hit, s, attacker, &hit);
+    place_boxes(&body->hurt, s, defender, &hurt);
+
+    /* Every hit lane against every hurt lane; empty lanes never overlap */
+    int overlap = 0;
+    for (int i = 0; i < FRAME_BOX_LANES; ++i)
+        for (int j = 0; j < FRAME_BOX_LANES; ++j)
+            overlap |= (hit.x0[i] < hurt.x1[j]) & (hurt.x0[j] < hit.x1[i]) & (hit.y0[i] < hurt.y1[j]) &
+                       (hurt.y0[j] < hit.y1[i]);
+    return overlap != 0;
+}
+
+bool frame_data_attack_hits(const FighterStore *s, int attacker, int defender)
+{
+    if (s->state[attacker] != FIGHTER_ATTACKING && s->state[attacker] != FIGHTER_DOWN_ATTACK)
+        return false;
+    return frame_data_hits(s, attacker, defender);
+}
+
+static void outline_boxes(SDL_Renderer *renderer, const FrameBoxes *boxes, int count, SDL_Color color)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        SDL_FRect r = {boxes->x0[i], boxes->y0[i], boxes->x1[i] - boxes->x0[i], boxes->y1[i] - boxes->y0[i]};
+        sprite_batch_outline(renderer, &r, color);
+    }
+}
+
+void frame_data_render_boxes(SDL_Renderer *renderer, const FighterStore *s)
+{
+    if (!renderer || !table_loaded)
+        return;
+    for (int id = 0; id < s->count; ++id)
+    {
+        const FrameData *d = fighter_frame(s, id);
+        FrameBoxes placed;
+        place_boxes(&d->hurt, s, id, &placed);
+        outline_boxes(renderer, &placed, d->hurt_count, (SDL_Color){80, 160, 255, 255});
+        if (d->phase == PHASE_ACTIVE)
+        {
+            place_boxes(&d->hit, s, id, &placed);
+            outline_boxes(renderer, &placed, d->hit_count, (SDL_Color){255, 60, 60, 255});
+        }
+    }
+}
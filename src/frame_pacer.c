@@ -0,0 +1,95 @@
+#include "frame_pacer.h"
+#include <math.h>
+#include <string.h>
+
+/* Bounds on the spin: below 1 ms SDL_Delay's own rounding misses deadlines,
+ * and an OS that oversleeps by more than 4 ms is not worth a core */
+#define SPIN_MIN_MS 1
+#define SPIN_MAX_MS 4
+
+void frame_pacer_init(FramePacer *pacer, int target_fps)
+{
+    memset(pacer, 0, sizeof(*pacer));
+    pacer->hz = SDL_GetPerformanceFrequency();
+    pacer->period = target_fps > 0 ? pacer->hz / (Uint64)target_fps : 0;
+    pacer->spin_margin = pacer->hz * 2 / 1000;
+    pacer->last_frame = SDL_GetPerformanceCounter();
+    pacer->deadline = pacer->last_frame + pacer->period;
+}
+
+static void sleep_until(FramePacer *pacer, Uint64 now)
+{
+    Uint64 min_margin = pacer->hz * SPIN_MIN_MS / 1000;
+    Uint64 max_margin = pacer->hz * SPIN_MAX_MS / 1000;
+
+    Uint64 remaining = pacer->deadline - now;
+    if (remaining > pacer->spin_margin)
+    {
+        Uint32 ms = (Uint32)((remaining - pacer->spin_margin) * 1000 / pacer->hz);
+        if (ms > 0)
+        {
+            SDL_Delay(ms);
+            Uint64 slept = SDL_GetPerformanceCounter() - now;
+            Uint64 asked = (Uint64)ms * pacer->hz / 1000;
+            Uint64 over = slept > asked ? slept - asked : 0;
+            /* Jump up to cover an overshoot, ease back down a little per frame */
+            if (over > pacer->spin_margin)
+                pacer->spin_margin = over < max_margin ? over : max_margin;
+            else
+                pacer->spin_margin -= (pacer->spin_margin - over) / 32;
+            if (pacer->spin_margin < min_margin)
+                pacer->spin_margin = min_margin;
+        }
+    }
+    while ((Sint64)(pacer->deadline - SDL_GetPerformanceCounter()) > 0)
+        ;
+}
+
+void frame_pacer_wait(FramePacer *pacer)
+{
+    Uint64 now = SDL_GetPerformanceCounter();
+    if (pacer->period)
+    {
+        Sint64 late = (Sint64)(now - pacer->deadline);
+        if (late > (Sint64)pacer->period)
+            pacer->deadline = now;
+        else if (late < 0)
+            sleep_until(pacer, now);
+        pacer->deadline += pacer->period;
+        now = SDL_GetPerformanceCounter();
+    }
+
+    pacer->intervals[pacer->pos] = (float)((double)(now - pacer->last_frame) * 1000.0 / (double)pacer->hz);
+    pacer->pos = (pacer->pos + 1) % FRAME_PACER_HISTORY;
+    if (pacer->count < FRAME_PACER_HISTORY)
+        pacer->count++;
+    pacer->last_frame = now;
+}
+
+void frame_pacer_stats(const FramePacer *pacer, FramePacerStats *stats)
+{
+    memset(stats, 0, sizeof(*stats));
+    stats->frames = pacer->count;
+    stats->target_ms = (float)((double)pacer->period * 1000.0 / (double)pacer->hz);
+    if (pacer->count == 0)
+        return;
+
+    double sum = 0.0, sum_sq = 0.0;
+    for (int i = 0; i < pacer->count; ++i)
+    {
+        sum += pacer->intervals[i];
+        sum_sq += (double)pacer->intervals[i] * pacer->intervals[i];
+    }
+    double mean = sum / pacer->count;
+    double variance = sum_sq / pacer->count - mean * mean;
+    stats->mean_ms = (float)mean;
+    stats->jitter_ms = variance > 0.0 ? (float)sqrt(variance) : 0.0f;
+
+    float expected = pacer->period ? stats->target_ms : stats->mean_ms;
+    for (int i = 0; i < pacer->count; ++i)
+    {
+        float off = fabsf(pacer->intervals[i] - expected);
+        if (off > stats->worst_ms)
+            stats->worst_ms = off;
+    }
+}
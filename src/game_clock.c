@@ -0,0 +1,33 @@
+#include "game_clock.h"
+
+void game_clock_init(GameClock *clock, Uint32 step_ms)
+{
+    clock->now = 0;
+    clock->step_ms = step_ms;
+    clock->tick = 0;
+    clock->delta_ms = 0;
+    clock->scale = GAME_CLOCK_SCALE_ONE;
+    clock->carry = 0;
+    clock->scale_ticks = 0;
+}
+
+void game_clock_advance(GameClock *clock)
+{
+    Uint32 scaled = clock->step_ms * clock->scale + clock->carry;
+    clock->delta_ms = scaled / GAME_CLOCK_SCALE_ONE;
+    clock->carry = (Uint16)(scaled % GAME_CLOCK_SCALE_ONE);
+    clock->now += clock->delta_ms;
+    clock->tick++;
+
+    if (clock->scale_ticks > 0 && --clock->scale_ticks == 0)
+    {
+        clock->scale = GAME_CLOCK_SCALE_ONE;
+        clock->carry = 0;
+    }
+}
+
+void game_clock_set_scale(GameClock *clock, Uint16 scale, Uint32 ticks)
+{
+    clock->scale = ticks > 0 ? scale : GAME_CLOCK_SCALE_ONE;
+    clock->scale_ticks = ticks;
+}
@@ -1,29 +1,183 @@
 #include "game_text.h"
+#include "asset_pack.h"
+#include "sprite_batch.h"
+#include <math.h>
 #include <stdio.h>
+#include <string.h>
 
-// A global font that our functions will use
-static TTF_Font* gFont = NULL;
+// Printable ASCII is all the game draws; anything else shows as '?'
+#define FIRST_GLYPH 32
+#define LAST_GLYPH 126
+#define GLYPH_COUNT (LAST_GLYPH - FIRST_GLYPH + 1)
+#define MAX_TEXT_SIZES 4
+#define GLYPH_ATLAS_WIDTH 1024
+#define GLYPH_PADDING 1
 
-// Helper function to render a single line of text
-static void render_text(SDL_Renderer *renderer, const char *text, int x, int y, SDL_Color color) {
-    if (!gFont) return;
+typedef struct {
+    SDL_Rect src; // cell in the atlas (w == 0 for blank glyphs)
+    int advance;
+} Glyph;
 
-    SDL_Surface* textSurface = TTF_RenderText_Solid(gFont, text, color);
-    if (!textSurface) {
-        fprintf(stderr, "Unable to render text surface! SDL_ttf Error: %s\n", TTF_GetError());
-        return;
+// Every glyph of one point size, rasterized once into a single texture
+typedef struct {
+    int size; // 0 = free slot
+    int line_height;
+    int atlas_w, atlas_h;
+    SDL_Surface* pixels;  // rasterized glyphs, until the first draw uploads them
+    SDL_Texture* texture;
+    Glyph glyphs[GLYPH_COUNT];
+} GlyphAtlas;
+
+static char gFontPath[256];
+static int gDefaultSize = 0;
+static GlyphAtlas gAtlases[MAX_TEXT_SIZES];
+
+// Draw-time scratch, so drawing text never allocates
+static TextLayout gScratch;
+
+static bool rasterize_glyphs(GlyphAtlas* atlas, int size) {
+    TTF_Font* font = TTF_OpenFontRW(asset_pack_rw(gFontPath), 1, size);
+    if (!font) {
+        fprintf(stderr, "Failed to load font at size %d! SDL_ttf Error: %s\n", size, TTF_GetError());
+        return false;
     }
 
-    SDL_Texture* textTexture = SDL_CreateTextureFromSurface(renderer, textSurface);
-    if (!textTexture) {
-        fprintf(stderr, "Unable to create texture from rendered text! SDL Error: %s\n", SDL_GetError());
-    } else {
-        SDL_Rect renderQuad = { x - textSurface->w / 2, y - textSurface->h / 2, textSurface->w, textSurface->h };
-        SDL_RenderCopy(renderer, textTexture, NULL, &renderQuad);
-        SDL_DestroyTexture(textTexture);
+    // Solid (not blended) keeps the pixel font crisp, as before; white so
+    // any colour can be applied per vertex
+    SDL_Color white = {255, 255, 255, 255};
+    SDL_Surface* rendered[GLYPH_COUNT];
+    int x = 0, y = 0, row_h = 0;
+    for (int i = 0; i < GLYPH_COUNT; i++) {
+        Glyph* g = &atlas->glyphs[i];
+        int advance = 0;
+        TTF_GlyphMetrics(font, (Uint16)(FIRST_GLYPH + i), NULL, NULL, NULL, NULL, &advance);
+        g->advance = advance;
+
+        rendered[i] = TTF_RenderGlyph_Solid(font, (Uint16)(FIRST_GLYPH + i), white);
+        if (!rendered[i] || rendered[i]->w == 0) {
+            g->src = (SDL_Rect){0, 0, 0, 0};
+            continue;
+        }
+        if (x + rendered[i]->w > GLYPH_ATLAS_WIDTH) {
+            x = 0;
+            y += row_h + GLYPH_PADDING;
+            row_h = 0;
+        }
+        g->src = (SDL_Rect){x, y, rendered[i]->w, rendered[i]->h};
+        x += rendered[i]->w + GLYPH_PADDING;
+        if (rendered[i]->h > row_h) row_h = rendered[i]->h;
+    }
+    atlas->line_height = TTF_FontHeight(font);
+    atlas->atlas_w = GLYPH_ATLAS_WIDTH;
+    atlas->atlas_h = y + row_h;
+    TTF_CloseFont(font);
+
+    atlas->pixels = SDL_CreateRGBSurfaceWithFormat(0, atlas->atlas_w, atlas->atlas_h > 0 ? atlas->atlas_h : 1, 32, SDL_PIXELFORMAT_RGBA32);
+    if (atlas->pixels) {
+        SDL_FillRect(atlas->pixels, NULL, SDL_MapRGBA(atlas->pixels->format, 0, 0, 0, 0));
+    }
+    for (int i = 0; i < GLYPH_COUNT; i++) {
+        if (!rendered[i]) continue;
+        if (atlas->pixels && atlas->glyphs[i].src.w > 0) {
+            SDL_Rect dst = atlas->glyphs[i].src;
+            SDL_BlitSurface(rendered[i], NULL, atlas->pixels, &dst);
+        }
+        SDL_FreeSurface(rendered[i]);
+    }
+    if (!atlas->pixels) {
+        fprintf(stderr, "Unable to build glyph atlas! SDL Error: %s\n", SDL_GetError());
+        return false;
+    }
+    atlas->size = size;
+    return true;
+}
+
+static int atlas_for_size(int size) {
+    int free_slot = -1;
+    for (int i = 0; i < MAX_TEXT_SIZES; i++) {
+        if (gAtlases[i].size == size) return i;
+        if (gAtlases[i].size == 0 && free_slot < 0) free_slot = i;
+    }
+    if (free_slot < 0) {
+        fprintf(stderr, "Text: no room for font size %d (max %d sizes)\n", size, MAX_TEXT_SIZES);
+        return -1;
+    }
+    return rasterize_glyphs(&gAtlases[free_slot], size) ? free_slot : -1;
+}
+
+bool text_layout(TextLayout* layout, const char* text, int size) {
+    layout->count = 0;
+    layout->w = 0.0f;
+    layout->h = 0.0f;
+    layout->atlas = atlas_for_size(size > 0 ? size : gDefaultSize);
+    if (layout->atlas < 0) return false;
+
+    const GlyphAtlas* atlas = &gAtlases[layout->atlas];
+    float pen = 0.0f;
+    const unsigned char* p = (const unsigned char*)text;
+    for (; *p && layout->count < TEXT_MAX_GLYPHS; p++) {
+        unsigned char c = (*p >= FIRST_GLYPH && *p <= LAST_GLYPH) ? *p : '?';
+        const Glyph* g = &atlas->glyphs[c - FIRST_GLYPH];
+        if (g->src.w > 0) {
+            TextQuad* q = &layout->quads[layout->count++];
+            q->dst = (SDL_FRect){pen, 0.0f, (float)g->src.w, (float)g->src.h};
+            q->uv0 = (SDL_FPoint){(float)g->src.x / atlas->atlas_w, (float)g->src.y / atlas->atlas_h};
+            q->uv1 = (SDL_FPoint){(float)(g->src.x + g->src.w) / atlas->atlas_w, (float)(g->src.y + g->src.h) / atlas->atlas_h};
+        }
+        pen += g->advance;
     }
+    layout->w = pen;
+    layout->h = (float)atlas->line_height;
+    return *p == '\0'; // false if the text was cut at TEXT_MAX_GLYPHS
+}
+
+void text_draw_layout(SDL_Renderer* renderer, const TextLayout* layout, int x, int y, SDL_Color color, TextAlign align) {
+    if (layout->atlas < 0 || layout->count == 0) return;
+    GlyphAtlas* atlas = &gAtlases[layout->atlas];
+
+    if (!atlas->texture) {
+        atlas->texture = SDL_CreateTextureFromSurface(renderer, atlas->pixels);
+        if (!atlas->texture) {
+            fprintf(stderr, "Unable to upload glyph atlas! SDL Error: %s\n", SDL_GetError());
+            return;
+        }
+        SDL_SetTextureBlendMode(atlas->texture, SDL_BLENDMODE_BLEND);
+        SDL_FreeSurface(atlas->pixels);
+        atlas->pixels = NULL;
+    }
+
+    // Whole pixels keep the pixel font from smearing
+    float left = (float)x;
+    if (align == TEXT_ALIGN_CENTER) left -= floorf(layout->w / 2.0f);
+    if (align == TEXT_ALIGN_RIGHT) left -= layout->w;
+    float top = (float)y - floorf(layout->h / 2.0f);
+
+    // Glyphs join the sprite batch: consecutive strings of one size are one draw
+    for (int i = 0; i < layout->count; i++) {
+        const TextQuad* q = &layout->quads[i];
+        SDL_FRect dst = {left + q->dst.x, top + q->dst.y, q->dst.w, q->dst.h};
+        sprite_batch_quad(renderer, atlas->texture, &dst, q->uv0, q->uv1, color);
+    }
+}
+
+void text_draw(SDL_Renderer* renderer, const char* text, int x, int y, int size, SDL_Color color, TextAlign align) {
+    text_layout(&gScratch, text, size);
+    text_draw_layout(renderer, &gScratch, x, y, color, align);
+}
+
+// Layouts for the fixed screen strings, built on first use
+static TextLayout gRestartLayout;
+static TextLayout gWinLayouts[4];
+static bool gLayoutsReady = false;
 
-    SDL_FreeSurface(textSurface);
+static void prepare_screen_layouts(void) {
+    if (gLayoutsReady) return;
+    text_layout(&gRestartLayout, "Press Enter to Restart The Match", 0);
+    text_layout(&gWinLayouts[0], "You Win", 0);
+    text_layout(&gWinLayouts[1], "You got SMACKED!", 0);
+    text_layout(&gWinLayouts[2], "Player 1 Wins", 0);
+    text_layout(&gWinLayouts[3], "Player 2 Wins", 0);
+    gLayoutsReady = true;
 }
 
 bool text_init(const char* font_path, int font_size) {
@@ -32,8 +186,11 @@ bool text_init(const char* font_path, int font_size) {
         return false;
     }
 
-    gFont = TTF_OpenFont(font_path, font_size);
-    if (!gFont) {
+    snprintf(gFontPath, sizeof(gFontPath), "%s", font_path);
+    gDefaultSize = font_size;
+
+    // Rasterize the default size now so the first game-over screen is free
+    if (atlas_for_size(font_size) < 0) {
         fprintf(stderr, "Failed to load font! SDL_ttf Error: %s\n", TTF_GetError());
         return false;
     }
@@ -42,41 +199,156 @@ bool text_init(const char* font_path, int font_size) {
 }
 
 void text_quit(void) {
-    if (gFont) {
-        TTF_CloseFont(gFont);
-        gFont = NULL;
+    for (int i = 0; i < MAX_TEXT_SIZES; i++) {
+        if (gAtlases[i].texture) SDL_DestroyTexture(gAtlases[i].texture);
+        SDL_FreeSurface(gAtlases[i].pixels);
+        memset(&gAtlases[i], 0, sizeof(gAtlases[i]));
     }
+    gLayoutsReady = false;
     TTF_Quit();
 }
 
 void render_game_over_screen_single(SDL_Renderer *renderer, int winner) {
-    const char* win_text = "";
+    prepare_screen_layouts();
+    const TextLayout* win_text;
     if (winner == 1) { // Player wins
-        win_text = "You Win";
+        win_text = &gWinLayouts[0];
     } else { // Enemy wins
-        win_text = "You got SMACKED!";
+        win_text = &gWinLayouts[1];
     }
 
     SDL_Color white = {255, 255, 255, 255};
     SDL_Color gray = {180, 180, 180, 255};
 
     // Render the main text in the middle of a 1280x720 screen
-    render_text(renderer, win_text, 1280 / 2, 720 / 2 - 50, white);
+    text_draw_layout(renderer, win_text, 1280 / 2, 720 / 2 - 50, white, TEXT_ALIGN_CENTER);
     // Render the restart text below it
-    render_text(renderer, "Press Enter to Restart The Match", 1280 / 2, 720 / 2 + 50, gray);
+    text_draw_layout(renderer, &gRestartLayout, 1280 / 2, 720 / 2 + 50, gray, TEXT_ALIGN_CENTER);
 }
 
 void render_game_over_screen_multi(SDL_Renderer *renderer, int winner) {
-    char win_text[32];
+    prepare_screen_layouts();
+    const TextLayout* win_text;
     if (winner == 1) {
-        sprintf(win_text, "Player 1 Wins");
+        win_text = &gWinLayouts[2];
     } else {
-        sprintf(win_text, "Player 2 Wins");
+        win_text = &gWinLayouts[3];
     }
 
     SDL_Color white = {255, 255, 255, 255};
     SDL_Color gray = {180, 180, 180, 255};
     
-    render_text(renderer, win_text, 1280 / 2, 720 / 2 - 50, white);
-    render_text(renderer, "Press Enter to Restart The Match", 1280 / 2, 720 / 2 + 50, gray);
-}
\ No newline at end of file
+    text_draw_layout(renderer, win_text, 1280 / 2, 720 / 2 - 50, white, TEXT_ALIGN_CENTER);
+    text_draw_layout(renderer, &gRestartLayout, 1280 / 2, 720 / 2 + 50, gray, TEXT_ALIGN_CENTER);
+}
+
+void render_loading_screen(SDL_Renderer *renderer, float progress) {
+    if (progress < 0.0f) progress = 0.0f;
+    if (progress > 1.0f) progress = 1.0f;
+
+    SDL_Color white = {255, 255, 255, 255};
+    text_draw(renderer, "Loading", 1280 / 2, 720 / 2 - 50, 0, white, TEXT_ALIGN_CENTER);
+
+    SDL_FRect frame = { 1280 / 2 - 300, 720 / 2 + 20, 600, 24 };
+    SDL_FRect fill = { frame.x + 4, frame.y + 4, (float)(int)((frame.w - 8) * progress), frame.h - 8 };
+    sprite_batch_outline(renderer, &frame, white);
+    sprite_batch_fill(renderer, &fill, white);
+}
+
+void render_fps_counter(SDL_Renderer *renderer, float fps) {
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%.0f FPS", fps);
+    SDL_Color yellow = {255, 230, 0, 255};
+    text_draw(renderer, buf, 1280 - 12, 20, HUD_TEXT_SIZE, yellow, TEXT_ALIGN_RIGHT);
+}
+
+void render_frame_pacing(SDL_Renderer *renderer, const FramePacerStats *stats) {
+    char buf[TEXT_MAX_GLYPHS];
+    if (stats->target_ms > 0.0f)
+        snprintf(buf, sizeof(buf), "%.2f/%.2f ms  jitter %.2f  worst %.2f", stats->mean_ms, stats->target_ms,
+                 stats->jitter_ms, stats->worst_ms);
+    else
+        snprintf(buf, sizeof(buf), "%.2f ms  jitter %.2f  worst %.2f", stats->mean_ms, stats->jitter_ms,
+                 stats->worst_ms);
+    SDL_Color yellow = {255, 230, 0, 255};
+    text_draw(renderer, buf, 1280 - 12, 46, HUD_TEXT_SIZE, yellow, TEXT_ALIGN_RIGHT);
+}
+
+void render_waiting_screen(SDL_Renderer *renderer, const char *message) {
+    SDL_Color white = {255, 255, 255, 255};
+    text_draw(renderer, message, 1280 / 2, 720 / 2, 0, white, TEXT_ALIGN_CENTER);
+}
+
+void render_netplay_stats(SDL_Renderer *renderer, int input_delay_ms, int rollback_ms, int max_rollback_ms,
+                          Uint32 stalls) {
+    char buf[TEXT_MAX_GLYPHS];
+    snprintf(buf, sizeof(buf), "delay %d  rb %d/%d ms  stalls %u", input_delay_ms, rollback_ms, max_rollback_ms,
+             (unsigned)stalls);
+    SDL_Color yellow = {255, 230, 0, 255};
+    text_draw(renderer, buf, 1280 - 12, 72, HUD_TEXT_SIZE, yellow, TEXT_ALIGN_RIGHT);
+}
+
+#define PROFILER_TEXT_SIZE 16
+#define PROFILER_ROW 20
+#define PROFILER_PX_PER_MS 20.0f // a 60 Hz frame is ~333 px
+
+void render_profiler_overlay(SDL_Renderer *renderer, const ProfilerStats *stats, bool tracing) {
+    SDL_Color white = {255, 255, 255, 255};
+    SDL_Color yellow = {255, 230, 0, 255};
+    char buf[TEXT_MAX_GLYPHS];
+    int x = 12, y = 12;
+    int bar_x = x + 140, bar_max = 360;
+    int histogram_h = 60;
+
+    SDL_FRect panel = {x - 6, y - 6, bar_x - x + bar_max + 80,
+                       PROF_ZONE_COUNT * PROFILER_ROW + histogram_h + 4 * PROFILER_ROW + 12};
+    sprite_batch_fill(renderer, &panel, (SDL_Color){0, 0, 0, 170});
+
+    for (int z = 0; z < PROF_ZONE_COUNT; ++z) {
+        int row_y = y + z * PROFILER_ROW;
+        int indent = profiler_zone_depth((ProfZone)z) * 12;
+        text_draw(renderer, profiler_zone_name((ProfZone)z), x + indent, row_y + PROFILER_ROW / 2,
+                  PROFILER_TEXT_SIZE, white, TEXT_ALIGN_LEFT);
+
+        int w = (int)(stats->zone_ms[z] * PROFILER_PX_PER_MS);
+        SDL_FRect bar = {bar_x, row_y + 4, w < bar_max ? w : bar_max, PROFILER_ROW - 8};
+        sprite_batch_fill(renderer, &bar, (SDL_Color){80, 200, 120, 255});
+
+        snprintf(buf, sizeof(buf), "%.2f", stats->zone_ms[z]);
+        text_draw(renderer, buf, bar_x + bar_max + 70, row_y + PROFILER_ROW / 2, PROFILER_TEXT_SIZE, white,
+                  TEXT_ALIGN_RIGHT);
+    }
+
+    // Frame-time histogram, 1 ms per column, with a line at 16.7 ms
+    y += PROF_ZONE_COUNT * PROFILER_ROW + 6;
+    int peak = 1;
+    for (int i = 0; i < PROF_HISTOGRAM_BINS; ++i)
+        if (stats->histogram[i] > peak)
+            peak = stats->histogram[i];
+    int column = bar_max / PROF_HISTOGRAM_BINS;
+    for (int i = 0; i < PROF_HISTOGRAM_BINS; ++i) {
+        int h = stats->histogram[i] * histogram_h / peak;
+        SDL_FRect col = {bar_x + i * column, y + histogram_h - h, column - 1, h};
+        sprite_batch_fill(renderer, &col, (SDL_Color){120, 160, 255, 255});
+    }
+    int budget_x = bar_x + (int)(1000.0f / 60.0f * (float)column);
+    SDL_FRect budget = {budget_x, y, 1, histogram_h};
+    sprite_batch_fill(renderer, &budget, (SDL_Color){255, 80, 80, 255});
+    text_draw(renderer, "frame ms", x, y + histogram_h / 2, PROFILER_TEXT_SIZE, white, TEXT_ALIGN_LEFT);
+
+    y += histogram_h + PROFILER_ROW / 2 + 4;
+    snprintf(buf, sizeof(buf), "p50 %.1f  p99 %.1f  max %.1f ms  (%d frames)", stats->frame_p50, stats->frame_p99,
+             stats->frame_max, stats->frames);
+    text_draw(renderer, buf, x, y, PROFILER_TEXT_SIZE, yellow, TEXT_ALIGN_LEFT);
+    y += PROFILER_ROW;
+    if (tracing)
+        snprintf(buf, sizeof(buf), "tracing - F5 to stop");
+    else
+        snprintf(buf, sizeof(buf), "F5 trace  dropped %u", (unsigned)stats->dropped);
+    text_draw(renderer, buf, x, y, PROFILER_TEXT_SIZE, tracing ? yellow : white, TEXT_ALIGN_LEFT);
+    y += PROFILER_ROW;
+    int quads, draws;
+    sprite_batch_stats(&quads, &draws);
+    snprintf(buf, sizeof(buf), "last frame: %d quads in %d draw calls", quads, draws);
+    text_draw(renderer, buf, x, y, PROFILER_TEXT_SIZE, white, TEXT_ALIGN_LEFT);
+}
@@ -0,0 +1,678 @@
+#include "headless.h"
+#include "sim.h"
+#include "netplay.h"
+#include "replay.h"
+#include "asset_cache.h"
+#include "asset_pack.h"
+#include "match_arena.h"
+#include "alloc_debug.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define HEADLESS_STEP_MS SIM_STEP_MS /* same fixed step as the windowed game */
+#define DEFAULT_MATCHES 1000
+#define DEFAULT_TIME_LIMIT_MS (99 * 1000)
+#define DEFAULT_RTT_MS 100
+
+/* --verify: where the snapshot is taken, and how many save/restore pairs
+ * are timed */
+#define VERIFY_SNAPSHOT_MS 3000
+#define VERIFY_TIMING_ROUNDS 10000
+
+#define BOT_ATTACK_RANGE 180.0f
+
+/* ---------- Bot ---------- */
+
+/* What the bot can see of a fighter */
+typedef struct
+{
+    float x;
+    bool facing_right;
+    bool on_ground;
+    bool is_attacking;
+} BotView;
+
+typedef struct
+{
+    SimRng rng;      /* separate from the match's, so it never perturbs the AI */
+    bool attack_held; /* the game only attacks on a fresh press */
+    int block_ticks;  /* keep holding block for a while once started */
+} Bot;
+
+static Uint32 bot_rand(Bot *bot)
+{
+    return sim_rng_next(&bot->rng);
+}
+
+static void bot_press_keys(Bot *bot, BotView self, BotView foe, const FighterKeymap *keys, Uint8 *keystate)
+{
+    float dx = foe.x - self.x;
+    float dist = dx < 0 ? -dx : dx;
+    bool foe_on_right = dx > 0;
+
+    if (bot->block_ticks > 0)
+    {
+        bot->block_ticks--;
+        keystate[keys->block] = 1;
+        return;
+    }
+
+    if (dist > BOT_ATTACK_RANGE)
+    {
+        keystate[foe_on_right ? keys->right : keys->left] = 1;
+        if (bot_rand(bot) % 150 == 0)
+            keystate[keys->jump] = 1;
+        else if (bot_rand(bot) % 200 == 0)
+            keystate[keys->slide] = 1;
+        bot->attack_held = false;
+        return;
+    }
+
+    /* In range: turn to face the opponent first; walking is what turns us */
+    if (self.facing_right != foe_on_right)
+    {
+        keystate[foe_on_right ? keys->right : keys->left] = 1;
+        bot->attack_held = false;
+        return;
+    }
+
+    if (foe.is_attacking && bot_rand(bot) % 3 == 0)
+    {
+        bot->block_ticks = 20 + bot_rand(bot) % 40;
+        keystate[keys->block] = 1;
+        return;
+    }
+
+    if (!self.on_ground)
+    {
+        keystate[keys->down_attack] = 1;
+        return;
+    }
+
+    if (!bot->attack_held && bot_rand(bot) % 6 == 0)
+    {
+        keystate[keys->attack] = 1;
+        bot->attack_held = true;
+    }
+    else
+    {
+        bot->attack_held = false;
+    }
+}
+
+static BotView view_fighter(const FighterStore *f, int id)
+{
+    return (BotView){f->x[id], f->direction[id] == FACING_RIGHT,
+                     (f->flags[id] & FIGHTER_ON_GROUND) != 0, (f->flags[id] & FIGHTER_IS_ATTACKING) != 0};
+}
+
+/* The bot on `side` (0 = player 1) presses that player's keys, exactly as
+ * a keyboard would */
+static FighterInput bot_input(const SimState *sim, Bot *bot, int side)
+{
+    const FighterKeymap *keys = side == 0 ? &keymap_p1 : &keymap_p2;
+    int self = side == 0 ? sim->p1 : sim->p2;
+    int foe = side == 0 ? sim->p2 : sim->p1;
+
+    Uint8 keystate[SDL_NUM_SCANCODES];
+    memset(keystate, 0, sizeof(keystate));
+    bot_press_keys(bot, view_fighter(&sim->fighters, self), view_fighter(&sim->fighters, foe), keys, keystate);
+    return fighter_read_keys(keys, keystate);
+}
+
+/* Player 1 is always a bot; player 2 too in multiplayer (else the AI) */
+static void bot_inputs(const SimState *sim, Bot *bot1, Bot *bot2, FighterInput inputs[MAX_FIGHTERS])
+{
+    memset(inputs, 0, MAX_FIGHTERS * sizeof(FighterInput));
+    inputs[sim->p1] = bot_input(sim, bot1, 0);
+    if (sim->multiplayer)
+        inputs[sim->p2] = bot_input(sim, bot2, 1);
+}
+
+/* `search` (may be NULL) plays the opponent; `record` (may be NULL) gets
+ * every tick's inputs */
+static void play_until(SimState *sim, Bot *bot1, Bot *bot2, AiSearch *search, Uint32 until_ms, Replay *record)
+{
+    FighterInput inputs[MAX_FIGHTERS];
+    while (!sim_fight_over(sim) && sim->clock.now < until_ms)
+    {
+        bot_inputs(sim, bot1, bot2, inputs);
+        if (search)
+            inputs[sim->p2] = ai_search_input(search, sim);
+        if (record)
+            replay_record(record, inputs[sim->p1], inputs[sim->p2]);
+        sim_step(sim, inputs);
+    }
+}
+
+/* Rewinds to a mid-match snapshot (bots and search included) and plays the
+ * rest again; the two endings must match byte for byte */
+static bool verify_replay(const HeadlessConfig *config, SimState *sim, SimState *snapshot, Bot *bot1, Bot *bot2,
+                          AiSearch *search)
+{
+    play_until(sim, bot1, bot2, search, VERIFY_SNAPSHOT_MS, NULL);
+    sim_save(sim, snapshot);
+    Bot saved1 = *bot1, saved2 = *bot2;
+    AiSearch saved_search;
+    if (search)
+        saved_search = *search;
+
+    play_until(sim, bot1, bot2, search, config->time_limit_ms, NULL);
+    Uint32 first = sim_checksum(sim);
+    Uint32 first_tick = sim->clock.tick;
+
+    sim_restore(sim, snapshot);
+    *bot1 = saved1;
+    *bot2 = saved2;
+    if (search)
+        *search = saved_search;
+    play_until(sim, bot1, bot2, search, config->time_limit_ms, NULL);
+
+    if (sim_checksum(sim) != first || sim->clock.tick != first_tick)
+    {
+        fprintf(stderr, "Headless: replay from tick %u diverged (checksum %08x vs %08x)\n",
+                (unsigned)snapshot->clock.tick, (unsigned)sim_checksum(sim), (unsigned)first);
+        return false;
+    }
+    return true;
+}
+
+/* Returns the winner (1 or 2), 0 for a draw, -1 if the match could not
+ * start, touched the heap between ticks (alloc-check builds) or, with
+ * --verify, did not replay identically. `record` (may be NULL) receives
+ * the match as a replay. */
+static int run_match(const HeadlessConfig *config, MatchArena *arena, Uint32 seed, Bot *bot1, Bot *bot2,
+                     Replay *record, HeadlessStats *stats)
+{
+    match_arena_reset(arena);
+    SimState *sim = (SimState *)match_arena_alloc(arena, sizeof(SimState));
+    SimState *snapshot = config->verify ? (SimState *)match_arena_alloc(arena, sizeof(SimState)) : NULL;
+    if (!sim || (config->verify && !snapshot))
+        return -1;
+    if (!sim_start(sim, config->multiplayer, seed, HEADLESS_STEP_MS))
+        return -1;
+    AiSearch search;
+    bool searching = config->ai != AI_CLASSIC && !config->multiplayer;
+    if (searching)
+    {
+        sim_opponent_by_input(sim);
+        ai_search_init(&search, sim, config->ai, false);
+    }
+
+    int heap_calls = alloc_debug_count();
+    bool ok = true;
+    if (config->verify)
+    {
+        ok = verify_replay(config, sim, snapshot, bot1, bot2, searching ? &search : NULL);
+    }
+    else
+    {
+        if (record)
+        {
+            replay_begin(record, seed, config->multiplayer, HEADLESS_STEP_MS);
+            if (searching)
+                record->header.flags |= REPLAY_OPPONENT_INPUT;
+        }
+        play_until(sim, bot1, bot2, searching ? &search : NULL, config->time_limit_ms, record);
+        if (record)
+            replay_end(record, sim);
+    }
+    stats->ticks += sim->clock.tick;
+    if (searching)
+    {
+        double us_per_tick = 1e6 / (double)SDL_GetPerformanceFrequency();
+        stats->ai_searches += search.searches;
+        stats->ai_cut_short += search.cut_short;
+        stats->ai_steps += search.steps;
+        stats->ai_us += (double)search.time * us_per_tick;
+        if ((double)search.slowest * us_per_tick > stats->ai_slowest_us)
+            stats->ai_slowest_us = (double)search.slowest * us_per_tick;
+    }
+
+    if (alloc_debug_count() != heap_calls)
+    {
+        fprintf(stderr, "Headless: %d heap call(s) during a match\n", alloc_debug_count() - heap_calls);
+        ok = false;
+    }
+    return ok ? sim_winner(sim) : -1;
+}
+
+/* ---------- Batch matches ---------- */
+
+bool headless_play_match(SimState *sim, bool multiplayer, Uint32 seed, Uint32 time_limit_ms,
+                         const AiTuning *enemy_ai, HeadlessMatch *out)
+{
+    if (!sim_start(sim, multiplayer, seed, HEADLESS_STEP_MS))
+        return false;
+    if (enemy_ai && !multiplayer)
+        sim->fighters.ai[sim->p2] = *enemy_ai;
+
+    Bot bot1 = {{0}, false, 0}, bot2 = {{0}, false, 0};
+    sim_rng_seed(&bot1.rng, seed * 2654435761u);
+    sim_rng_seed(&bot2.rng, seed * 2246822519u);
+
+    memset(out, 0, sizeof(*out));
+    int health[2] = {sim_health(sim, 0), sim_health(sim, 1)};
+    FighterInput inputs[MAX_FIGHTERS];
+    while (!sim_fight_over(sim) && sim->clock.now < time_limit_ms)
+    {
+        /* Hits land mid-swing, so the move each side was in going into the
+         * step is the one that hit (a finishing blow switches the winner to
+         * its victory pose within the step) */
+        Uint8 moves[2] = {sim->fighters.anim[sim->p1], sim->fighters.anim[sim->p2]};
+        bot_inputs(sim, &bot1, &bot2, inputs);
+        sim_step(sim, inputs);
+
+        for (int side = 0; side < 2; ++side)
+        {
+            int left = sim_health(sim, side);
+            if (left < health[side])
+                out->damage[1 - side][moves[1 - side]] += (Uint32)(health[side] - left);
+            health[side] = left;
+        }
+    }
+    out->winner = sim_winner(sim);
+    out->ticks = sim->clock.tick;
+    return true;
+}
+
+/* ---------- Netplay ---------- */
+
+/* Two peers in one process, each with its own session, talking through
+ * in-memory pipes behind the bad-network simulator. A third, plain
+ * simulation follows the inputs both peers have confirmed; every confirmed
+ * state either peer still holds must match it byte for byte. */
+typedef struct
+{
+    NetPipe pipes[2]; /* [0]: peer 0 -> peer 1 */
+    NetPipeEnd ends[2];
+    NetLinkSim links[2];
+    NetplaySession peers[2];
+    SimState reference;
+} NetplayMatch;
+
+static int run_netplay_match(const HeadlessConfig *config, MatchArena *arena, Uint32 seed, Bot *bot1, Bot *bot2,
+                             HeadlessStats *stats)
+{
+    match_arena_reset(arena);
+    NetplayMatch *m = (NetplayMatch *)match_arena_alloc(arena, sizeof(NetplayMatch));
+    if (!m)
+        return -1;
+
+    for (int p = 0; p < 2; ++p)
+    {
+        net_pipe_init(&m->pipes[p]);
+        m->ends[p] = (NetPipeEnd){&m->pipes[p], &m->pipes[1 - p]};
+        net_link_sim_init(&m->links[p], net_pipe_link(&m->ends[p]), config->net, seed * 2u + (Uint32)p);
+        if (!netplay_start(&m->peers[p], net_link_sim_link(&m->links[p]), p, seed,
+                           config->input_delay, config->rollback_window))
+            return -1;
+    }
+    if (!sim_start(&m->reference, true, seed, HEADLESS_STEP_MS))
+        return -1;
+
+    /* A peer can stall, so allow for far more steps than ticks */
+    Uint32 max_steps = config->time_limit_ms / HEADLESS_STEP_MS * 4 + 1000;
+    SimState *ref = &m->reference;
+    for (Uint32 step = 0; !sim_fight_over(ref) && ref->clock.now < config->time_limit_ms; ++step)
+    {
+        if (step == max_steps)
+        {
+            fprintf(stderr, "Headless: netplay stuck at tick %u\n", (unsigned)ref->clock.tick);
+            return -1;
+        }
+        Uint32 now = step * HEADLESS_STEP_MS;
+        for (int p = 0; p < 2; ++p)
+            net_link_sim_pump(&m->links[p], now);
+
+        /* Each bot only sees its own peer's (possibly predicted) present */
+        netplay_step(&m->peers[0], bot_input(&m->peers[0].sim, bot1, 0));
+        netplay_step(&m->peers[1], bot_input(&m->peers[1].sim, bot2, 1));
+        if (m->peers[0].desynced || m->peers[1].desynced)
+            return -1;
+
+        Uint32 c0 = netplay_confirmed_tick(&m->peers[0]), c1 = netplay_confirmed_tick(&m->peers[1]);
+        Uint32 confirmed = c0 < c1 ? c0 : c1;
+        while (ref->clock.tick < confirmed && !sim_fight_over(ref) && ref->clock.now < config->time_limit_ms)
+        {
+            FighterInput inputs[MAX_FIGHTERS];
+            netplay_tick_inputs(&m->peers[0], ref->clock.tick, inputs);
+            sim_step(ref, inputs);
+
+            Uint32 expect = sim_checksum(ref);
+            for (int p = 0; p < 2; ++p)
+            {
+                const SimState *state = netplay_state_at(&m->peers[p], ref->clock.tick);
+                if (!state)
+                    continue; /* already dropped from that peer's ring */
+                if (sim_checksum(state) != expect)
+                {
+                    fprintf(stderr, "Headless: peer %d differs from the reference at tick %u\n",
+                            p, (unsigned)ref->clock.tick);
+                    return -1;
+                }
+                stats->net_checked++;
+            }
+        }
+    }
+
+    for (int p = 0; p < 2; ++p)
+    {
+        const NetplayStats *n = &m->peers[p].stats;
+        stats->net_rollbacks += n->rollbacks;
+        stats->net_resimulated += n->resimulated;
+        stats->net_stalls += n->stalls;
+        stats->net_sync_waits += n->sync_waits;
+        if (n->max_rollback > stats->net_max_rollback)
+            stats->net_max_rollback = n->max_rollback;
+    }
+    stats->ticks += ref->clock.tick;
+    return sim_winner(ref);
+}
+
+/* ---------- Replays ---------- */
+
+/* Re-runs a recorded match flat out, timing every tick, and checks it ends
+ * in the recorded state */
+static bool play_replay(const Replay *replay, MatchArena *arena)
+{
+    match_arena_reset(arena);
+    SimState *sim = (SimState *)match_arena_alloc(arena, sizeof(SimState));
+    if (!sim || !replay_start_sim(replay, sim))
+        return false;
+
+    ReplayCursor cursor;
+    replay_cursor_init(&cursor, replay);
+    FighterInput p1, p2;
+    Uint64 freq = SDL_GetPerformanceFrequency();
+    Uint64 slowest = 0;
+    Uint32 slowest_tick = 0;
+    Uint64 start = SDL_GetPerformanceCounter();
+    while (replay_cursor_next(&cursor, &p1, &p2))
+    {
+        FighterInput inputs[MAX_FIGHTERS] = {0};
+        inputs[sim->p1] = p1;
+        inputs[sim->p2] = p2;
+
+        Uint64 t0 = SDL_GetPerformanceCounter();
+        sim_step(sim, inputs);
+        Uint64 dt = SDL_GetPerformanceCounter() - t0;
+        if (dt > slowest)
+        {
+            slowest = dt;
+            slowest_tick = sim->clock.tick;
+        }
+    }
+    double secs = (double)(SDL_GetPerformanceCounter() - start) / (double)freq;
+    if (secs <= 0.0)
+        secs = 1e-9;
+
+    const ReplayHeader *h = &replay->header;
+    double played = cursor.tick * (h->step_ms / 1000.0);
+    printf("Replayed %u ticks (%.1f s of play, seed %u, %s) in %.2f ms: %.0fx real time\n",
+           (unsigned)cursor.tick, played, (unsigned)h->seed,
+           (h->flags & REPLAY_MULTIPLAYER) ? "multiplayer" : "single-player", secs * 1000.0, played / secs);
+    printf("Slowest tick: %u (%.2f us)  winner: %d%s\n", (unsigned)slowest_tick,
+           (double)slowest * 1e6 / (double)freq, sim_winner(sim),
+           (h->flags & REPLAY_TRUNCATED) ? "  (recording was cut short)" : "");
+
+    if (cursor.tick != h->ticks)
+    {
+        fprintf(stderr, "Replay: data ends at tick %u of %u\n", (unsigned)cursor.tick, (unsigned)h->ticks);
+        return false;
+    }
+    if ((h->flags & REPLAY_HAS_CHECKSUM) && sim_checksum(sim) != h->final_checksum)
+    {
+        fprintf(stderr, "Replay: diverged from the recording (checksum %08x, recorded %08x)\n",
+                (unsigned)sim_checksum(sim), (unsigned)h->final_checksum);
+        return false;
+    }
+    if (h->flags & REPLAY_HAS_CHECKSUM)
+        printf("Final state matches the recording.\n");
+    return true;
+}
+
+/* Average cost of one sim_save + sim_restore pair, in microseconds */
+static double time_snapshots(MatchArena *arena)
+{
+    match_arena_reset(arena);
+    SimState *sim = (SimState *)match_arena_alloc(arena, sizeof(SimState));
+    SimState *snapshot = (SimState *)match_arena_alloc(arena, sizeof(SimState));
+    if (!sim || !snapshot || !sim_start(sim, false, 1, HEADLESS_STEP_MS))
+        return 0.0;
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (int i = 0; i < VERIFY_TIMING_ROUNDS; ++i)
+    {
+        sim_save(sim, snapshot);
+        sim->clock.tick = (Uint32)i; /* keep the copies from being folded away */
+        sim_restore(sim, snapshot);
+    }
+    Uint64 elapsed = SDL_GetPerformanceCounter() - start;
+    return (double)elapsed * 1e6 / (double)SDL_GetPerformanceFrequency() / VERIFY_TIMING_ROUNDS;
+}
+
+/* A dash (forward, forward) whose second press comes after a hitstop
+ * longer than the command window: the freeze must hold the window too */
+static bool verify_command_hitstop(MatchArena *arena)
+{
+    match_arena_reset(arena);
+    SimState *sim = (SimState *)match_arena_alloc(arena, sizeof(SimState));
+    if (!sim || !sim_start(sim, false, 1, HEADLESS_STEP_MS))
+        return false;
+    FighterStore *f = &sim->fighters;
+    int p1 = sim->p1;
+    FighterInput forward = f->x[sim->p2] > f->x[p1] ? INPUT_RIGHT : INPUT_LEFT;
+    FighterInput inputs[MAX_FIGHTERS] = {0};
+
+    inputs[p1] = forward;
+    sim_step(sim, inputs);
+    inputs[p1] = 0;
+    sim_step(sim, inputs);
+    f->hitstop_ms[p1] = (Uint16)(fighter_archetypes[f->archetype[p1]].command_window_ms * 2);
+    while (f->hitstop_ms[p1] > 0)
+        sim_step(sim, inputs);
+    inputs[p1] = forward;
+    sim_step(sim, inputs);
+
+    if (!(f->flags[p1] & FIGHTER_DASHING))
+    {
+        fprintf(stderr, "Headless: a command was dropped by the hitstop in the middle of it\n");
+        return false;
+    }
+    return true;
+}
+
+bool run_headless(const HeadlessConfig *config, HeadlessStats *stats)
+{
+    memset(stats, 0, sizeof(*stats));
+
+    Bot bot1 = {{0}, false, 0}, bot2 = {{0}, false, 0};
+    sim_rng_seed(&bot1.rng, config->seed * 2654435761u);
+    sim_rng_seed(&bot2.rng, config->seed * 2246822519u);
+
+    /* Sizes only: there is no renderer */
+    if (!fighter_assets_acquire(NULL))
+        return false;
+
+    /* One block for every match; each one resets it */
+    void *memory = malloc(MATCH_ARENA_SIZE);
+    if (!memory)
+    {
+        fprintf(stderr, "Headless: could not allocate the match arena.\n");
+        fighter_assets_release();
+        return false;
+    }
+    MatchArena arena;
+    match_arena_init(&arena, memory, MATCH_ARENA_SIZE);
+
+    /* The replay buffer is too big for the arena; it is reused by every match */
+    Replay *replay = NULL;
+    if (config->record_path || config->replay_path)
+    {
+        replay = (Replay *)malloc(sizeof(Replay));
+        if (!replay)
+        {
+            fprintf(stderr, "Headless: could not allocate the replay buffer.\n");
+            free(memory);
+            fighter_assets_release();
+            return false;
+        }
+    }
+
+    if (config->replay_path)
+    {
+        bool played = replay_load(replay, config->replay_path) && play_replay(replay, &arena);
+        free(replay);
+        free(memory);
+        fighter_assets_release();
+        return played;
+    }
+
+    bool ok = true;
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (int i = 0; i < config->matches; ++i)
+    {
+        /* Each match gets its own seed, so any one can be rerun alone */
+        Uint32 seed = config->seed + (Uint32)i;
+        int heap_calls = alloc_debug_count();
+        int winner = config->netplay ? run_netplay_match(config, &arena, seed, &bot1, &bot2, stats)
+                                     : run_match(config, &arena, seed, &bot1, &bot2, replay, stats);
+        if (config->netplay && alloc_debug_count() != heap_calls)
+        {
+            fprintf(stderr, "Headless: %d heap call(s) during a match\n", alloc_debug_count() - heap_calls);
+            winner = -1;
+        }
+        if (winner < 0)
+        {
+            fprintf(stderr, "Headless: match %d failed.\n", i);
+            ok = false;
+            break;
+        }
+        stats->matches++;
+        if (winner == 1)
+            stats->p1_wins++;
+        else if (winner == 2)
+            stats->p2_wins++;
+        else
+            stats->draws++;
+    }
+    stats->seconds = (double)(SDL_GetPerformanceCounter() - start) / (double)SDL_GetPerformanceFrequency();
+    if (config->verify)
+    {
+        stats->snapshot_us = time_snapshots(&arena);
+        if (ok && !verify_command_hitstop(&arena))
+            ok = false;
+    }
+
+    /* The last match's recording is the one left in the buffer */
+    if (ok && replay && stats->matches > 0 && !config->netplay && !config->verify)
+    {
+        if (replay_save(replay, config->record_path))
+            stats->replay_bytes = sizeof(ReplayHeader) + replay->header.data_size;
+        else
+            ok = false;
+    }
+    free(replay);
+    free(memory);
+    fighter_assets_release();
+    return ok;
+}
+
+static void print_usage(const char *prog)
+{
+    fprintf(stderr,
+            "usage: %s [--matches N] [--seed S] [--multi] [--time-limit SECONDS] [--verify]\n"
+            "          [--ai classic|easy|normal|hard]\n"
+            "          [--netplay [--rtt MS] [--jitter MS] [--loss PERCENT] [--delay TICKS] [--rollback TICKS]]\n"
+            "          [--record FILE (the last match)] | [--replay FILE]\n",
+            prog);
+}
+
+int headless_main(int argc, char *argv[])
+{
+    HeadlessConfig config = {DEFAULT_MATCHES, 1, false, DEFAULT_TIME_LIMIT_MS, false,
+                             false, {DEFAULT_RTT_MS / 2, 0, 0}, NETPLAY_DEFAULT_INPUT_DELAY, NETPLAY_DEFAULT_ROLLBACK,
+                             NULL, NULL, AI_CLASSIC};
+
+    for (int i = 1; i < argc; ++i)
+    {
+        bool has_value = i + 1 < argc;
+        if (strcmp(argv[i], "--matches") == 0 && has_value)
+            config.matches = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--seed") == 0 && has_value)
+            config.seed = (unsigned int)strtoul(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "--time-limit") == 0 && has_value)
+            config.time_limit_ms = (Uint32)atoi(argv[++i]) * 1000;
+        else if (strcmp(argv[i], "--multi") == 0)
+            config.multiplayer = true;
+        else if (strcmp(argv[i], "--verify") == 0)
+            config.verify = true;
+        else if (strcmp(argv[i], "--netplay") == 0)
+            config.netplay = config.multiplayer = true;
+        else if (strcmp(argv[i], "--rtt") == 0 && has_value)
+            config.net.latency_ms = (Uint32)atoi(argv[++i]) / 2;
+        else if (strcmp(argv[i], "--jitter") == 0 && has_value)
+            config.net.jitter_ms = (Uint32)atoi(argv[++i]);
+        else if (strcmp(argv[i], "--loss") == 0 && has_value)
+            config.net.loss_percent = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--delay") == 0 && has_value)
+            config.input_delay = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--rollback") == 0 && has_value)
+            config.rollback_window = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--record") == 0 && has_value)
+            config.record_path = argv[++i];
+        else if (strcmp(argv[i], "--replay") == 0 && has_value)
+            config.replay_path = argv[++i];
+        else if (strcmp(argv[i], "--ai") == 0 && has_value && ai_level_find(argv[i + 1]) >= 0)
+            config.ai = (AiLevel)ai_level_find(argv[++i]);
+        else
+        {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    asset_pack_open(ASSET_PACK_PATH); /* sheet sizes come from its index */
+    HeadlessStats stats;
+    bool ok = run_headless(&config, &stats);
+    asset_cache_clear();
+    asset_pack_close();
+    if (!ok)
+        return 1;
+    if (config.replay_path)
+        return 0;
+
+    double secs = stats.seconds > 0.0 ? stats.seconds : 1e-9;
+    printf("%d %s matches in %.3f s (%.0f matches/s, %.0f ticks/s)\n",
+           stats.matches, config.multiplayer ? "multiplayer" : "single-player",
+           stats.seconds, stats.matches / secs, stats.ticks / secs);
+    printf("P1 wins: %d  P2 wins: %d  draws: %d  avg length: %.1f s\n",
+           stats.p1_wins, stats.p2_wins, stats.draws,
+           stats.matches ? stats.ticks * (HEADLESS_STEP_MS / 1000.0) / stats.matches : 0.0);
+    if (config.netplay)
+    {
+        printf("Netplay at %u ms RTT (+%u ms jitter, %d%% loss): input delay %d ms, rollback window %d ms\n",
+               (unsigned)config.net.latency_ms * 2, (unsigned)config.net.jitter_ms, config.net.loss_percent,
+               config.input_delay * HEADLESS_STEP_MS, config.rollback_window * HEADLESS_STEP_MS);
+        printf("%u rollbacks (avg %.1f, max %u ticks), %u stalled steps, %u sync waits; "
+               "%lu confirmed states matched the reference\n",
+               (unsigned)stats.net_rollbacks,
+               stats.net_rollbacks ? (double)stats.net_resimulated / stats.net_rollbacks : 0.0,
+               (unsigned)stats.net_max_rollback, (unsigned)stats.net_stalls, (unsigned)stats.net_sync_waits,
+               (unsigned long)stats.net_checked);
+    }
+    if (stats.ai_searches)
+        printf("Lookahead AI (%s): %u searches, %.0f steps and %.1f us each (slowest %.1f us), %u cut short\n",
+               ai_level_name(config.ai), (unsigned)stats.ai_searches, (double)stats.ai_steps / stats.ai_searches,
+               stats.ai_us / stats.ai_searches, stats.ai_slowest_us, (unsigned)stats.ai_cut_short);
+    if (stats.replay_bytes)
+        printf("Recorded the last match to %s (%lu bytes)\n", config.record_path, (unsigned long)stats.replay_bytes);
+    if (config.verify)
+        printf("Every match replayed identically from a snapshot (%lu-byte state, %.2f us save+restore).\n",
+               (unsigned long)sizeof(SimState), stats.snapshot_us);
+    if (alloc_debug_enabled())
+        printf("No heap calls during any match.\n");
+    return 0;
+}
@@ -0,0 +1,191 @@
+#include "hot_reload.h"
+#include "asset_cache.h"
+#include "frame_data.h"
+#include "sound.h"
+#include <stdio.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <errno.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <dirent.h>
+
+#define HOT_RELOAD_MAX_DIRS 64
+#define HOT_RELOAD_MAX_CHANGES 32
+#define HOT_RELOAD_PATH_MAX 256
+
+/* A file counts as changed once it is closed after writing or renamed into
+ * place (how most editors and exporters save) */
+#define WATCH_EVENTS (IN_CLOSE_WRITE | IN_MOVED_TO)
+
+static int watch_fd = -1;
+static struct
+{
+    int wd;
+    char path[HOT_RELOAD_PATH_MAX];
+} watched[HOT_RELOAD_MAX_DIRS];
+static int watched_count = 0;
+
+static void watch_tree(const char *dir)
+{
+    if (watched_count == HOT_RELOAD_MAX_DIRS)
+    {
+        fprintf(stderr, "Hot reload: more than %d directories, not watching %s\n", HOT_RELOAD_MAX_DIRS, dir);
+        return;
+    }
+    int wd = inotify_add_watch(watch_fd, dir, WATCH_EVENTS);
+    if (wd < 0)
+    {
+        fprintf(stderr, "Hot reload: can't watch %s: %s\n", dir, strerror(errno));
+        return;
+    }
+    watched[watched_count].wd = wd;
+    snprintf(watched[watched_count].path, HOT_RELOAD_PATH_MAX, "%s", dir);
+    watched_count++;
+
+    DIR *d = opendir(dir);
+    if (!d)
+        return;
+    struct dirent *entry;
+    while ((entry = readdir(d)) != NULL)
+    {
+        if (entry->d_name[0] == '.')
+            continue;
+        char child[HOT_RELOAD_PATH_MAX];
+        if (snprintf(child, sizeof(child), "%s/%s", dir, entry->d_name) >= (int)sizeof(child))
+            continue;
+        DIR *sub = opendir(child);
+        if (sub)
+        {
+            closedir(sub);
+            watch_tree(child);
+        }
+    }
+    closedir(d);
+}
+
+bool hot_reload_start(const char *dir)
+{
+    if (watch_fd >= 0)
+        return true;
+    watch_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (watch_fd < 0)
+    {
+        fprintf(stderr, "Hot reload: inotify unavailable: %s\n", strerror(errno));
+        return false;
+    }
+    watch_tree(dir);
+    if (watched_count == 0)
+    {
+        hot_reload_stop();
+        return false;
+    }
+    printf("Hot reload: watching %d directories under %s\n", watched_count, dir);
+    return true;
+}
+
+void hot_reload_stop(void)
+{
+    if (watch_fd >= 0)
+        close(watch_fd);
+    watch_fd = -1;
+    watched_count = 0;
+}
+
+static const char *watched_dir(int wd)
+{
+    for (int i = 0; i < watched_count; ++i)
+        if (watched[i].wd == wd)
+            return watched[i].path;
+    return NULL;
+}
+
+/* Returns whether `path` was something we know how to reload */
+static bool reload_file(SDL_Renderer *renderer, FighterStore *fighters, const char *path)
+{
+    if (strcmp(path, FIGHTER_DEFS_PATH) == 0)
+        return fighter_defs_reload(renderer, fighters);
+    if (strcmp(path, FRAME_DATA_PATH) == 0)
+        return fighter_defs_loaded() && frame_data_load(path); /* else the first match loads it */
+    if (asset_cache_contains(path))
+    {
+        if (!asset_cache_reload(renderer, path))
+            return false;
+        fighter_assets_refresh(fighters); /* the sheet may have changed width */
+        return true;
+    }
+    return sound_reload(path);
+}
+
+int hot_reload_poll(SDL_Renderer *renderer, FighterStore *fighters)
+{
+    if (watch_fd < 0)
+        return 0;
+
+    /* Collect first: one save often raises several events for a file */
+    static char changes[HOT_RELOAD_MAX_CHANGES][HOT_RELOAD_PATH_MAX];
+    int change_count = 0;
+    union
+    {
+        struct inotify_event align;
+        char bytes[4096];
+    } buffer;
+    for (;;)
+    {
+        ssize_t len = read(watch_fd, buffer.bytes, sizeof(buffer.bytes));
+        if (len <= 0)
+            break;
+        for (char *p = buffer.bytes; p < buffer.bytes + len;)
+        {
+            const struct inotify_event *event = (const struct inotify_event *)p;
+            p += sizeof(struct inotify_event) + event->len;
+
+            const char *dir = watched_dir(event->wd);
+            if (!dir || event->len == 0 || event->name[0] == '.')
+                continue;
+            char path[HOT_RELOAD_PATH_MAX];
+            if (snprintf(path, sizeof(path), "%s/%s", dir, event->name) >= (int)sizeof(path))
+                continue;
+
+            bool seen = false;
+            for (int i = 0; i < change_count && !seen; ++i)
+                seen = strcmp(changes[i], path) == 0;
+            if (!seen && change_count < HOT_RELOAD_MAX_CHANGES)
+                strcpy(changes[change_count++], path);
+        }
+    }
+
+    int reloaded = 0;
+    for (int i = 0; i < change_count; ++i)
+    {
+        Uint64 start = SDL_GetPerformanceCounter();
+        if (!reload_file(renderer, fighters, changes[i]))
+            continue;
+        double ms = (double)(SDL_GetPerformanceCounter() - start) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+        printf("Hot reload: %s (%.1f ms)\n", changes[i], ms);
+        reloaded++;
+    }
+    return reloaded;
+}
+
+#else
+
+bool hot_reload_start(const char *dir)
+{
+    fprintf(stderr, "Hot reload: not supported on this platform (needs inotify); not watching %s\n", dir);
+    return false;
+}
+
+void hot_reload_stop(void)
+{
+}
+
+int hot_reload_poll(SDL_Renderer *renderer, FighterStore *fighters)
+{
+    (void)renderer;
+    (void)fighters;
+    return 0;
+}
+
+#endif
@@ -0,0 +1,80 @@
+#include "input_buffer.h"
+#include <string.h>
+
+#define INPUT_BUFFER_MASK (INPUT_BUFFER_SIZE - 1)
+
+/* Keys are numbered by the INPUT_* bit they drive; the second slide key
+ * takes the spare top bit */
+#define KEY_SLIDE_ALT 7
+
+void input_buffer_init(InputBuffer *buffer, const FighterKeymap *keys)
+{
+    memset(buffer, 0, sizeof(*buffer));
+    buffer->keys = keys;
+}
+
+static int key_index(const FighterKeymap *keys, SDL_Scancode code)
+{
+    const SDL_Scancode by_bit[] = {keys->left, keys->right, keys->jump, keys->attack,
+                                   keys->down_attack, keys->block, keys->slide};
+    for (int i = 0; i < (int)(sizeof(by_bit) / sizeof(by_bit[0])); ++i)
+        if (by_bit[i] == code)
+            return i;
+    if (keys->slide_alt != SDL_SCANCODE_UNKNOWN && keys->slide_alt == code)
+        return KEY_SLIDE_ALT;
+    return -1;
+}
+
+static void take(InputBuffer *buffer)
+{
+    const InputEvent *ev = &buffer->events[buffer->tail++ & INPUT_BUFFER_MASK];
+    if (ev->down)
+        buffer->keys_down |= (Uint8)(1u << ev->key);
+    else
+        buffer->keys_down &= (Uint8)~(1u << ev->key);
+}
+
+bool input_buffer_event(InputBuffer *buffer, const SDL_Event *e)
+{
+    if ((e->type != SDL_KEYDOWN && e->type != SDL_KEYUP) || e->key.repeat)
+        return false;
+    int key = key_index(buffer->keys, e->key.keysym.scancode);
+    if (key < 0)
+        return false;
+
+    /* Full: the oldest event loses its place in time but not its effect */
+    if (buffer->head - buffer->tail == INPUT_BUFFER_SIZE)
+        take(buffer);
+    InputEvent *ev = &buffer->events[buffer->head++ & INPUT_BUFFER_MASK];
+    ev->time = e->key.timestamp;
+    ev->key = (Uint8)key;
+    ev->down = e->type == SDL_KEYDOWN;
+    return true;
+}
+
+FighterInput input_buffer_step(InputBuffer *buffer, Uint32 until)
+{
+    Uint8 changed = 0;
+    while (buffer->tail != buffer->head)
+    {
+        const InputEvent *ev = &buffer->events[buffer->tail & INPUT_BUFFER_MASK];
+        Uint8 bit = (Uint8)(1u << ev->key);
+        /* Later than this step, or a second change to a key: next step */
+        if ((Sint32)(ev->time - until) > 0 || (changed & bit))
+            break;
+        if (((buffer->keys_down & bit) != 0) != ev->down)
+            changed |= bit;
+        take(buffer);
+    }
+
+    FighterInput in = (FighterInput)(buffer->keys_down & ~(1u << KEY_SLIDE_ALT));
+    if (buffer->keys_down & (1u << KEY_SLIDE_ALT))
+        in |= INPUT_SLIDE;
+    return in;
+}
+
+void input_buffer_flush(InputBuffer *buffer)
+{
+    while (buffer->tail != buffer->head)
+        take(buffer);
+}
@@ -5,19 +5,213 @@
 #include <stdio.h>
 #include <stdbool.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 #include "sound.h"
 #include "background.h"
-#include "player.h"
-#include "player2.h"
-#include "multifight.h"
-#include "singlefight.h"
+#include "sim.h"
 #include "game_text.h" // ADDED: Include for text rendering
+#include "headless.h"
+#include "asset_cache.h"
+#include "texture_atlas.h"
+#include "asset_pack.h"
+#include "asset_loader.h"
+#include "match_arena.h"
+#include "netplay.h"
+#include "net_udp.h"
+#include "replay.h"
+#include "profiler.h"
+#include "sprite_batch.h"
+#include "frame_data.h"
+#include "hot_reload.h"
+#include "input_buffer.h"
+#include "frame_pacer.h"
+#include "ai_search.h"
+
+/* Upper bound on catch-up work after a stall (window drag, driver hiccup);
+ * anything beyond this is dropped instead of teleporting the fighters. */
+#define SIM_MAX_STEPS_PER_FRAME 8
+/* Main-thread time per frame for finishing background loads (GPU uploads) */
+#define LOAD_BUDGET_US 4000
+/* The accumulator counts microseconds so interpolation is not stuck on
+ * whole milliseconds (an 8 ms step in eighths) at high frame rates */
+#define SIM_STEP_US (SIM_STEP_MS * 1000u)
+/* Replay playback steps per fixed step while TAB is held */
+#define REPLAY_FAST_FORWARD 8
+/* F5 starts and stops a capture; open it in chrome://tracing or Perfetto */
+#define TRACE_PATH "smack-trace.json"
+
+/* Everything a match owns comes out of the arena, so starting or
+ * restarting one is a reset plus a few bumps - no heap traffic */
+static SimState *start_match(MatchArena *arena, bool multiplayer, Uint32 seed, AiLevel ai, AiSearch *search)
+{
+    match_arena_reset(arena);
+    SimState *sim = (SimState *)match_arena_alloc(arena, sizeof(SimState));
+    if (!sim || !sim_start(sim, multiplayer, seed, SIM_STEP_MS))
+        return NULL;
+    if (!multiplayer && ai != AI_CLASSIC)
+    {
+        sim_opponent_by_input(sim);
+        ai_search_init(search, sim, ai, true);
+    }
+    return sim;
+}
+
+/* Whether the lookahead AI plays the opponent (its buttons are recorded) */
+static bool opponent_searches(const SimState *sim)
+{
+    return sim && !sim->multiplayer && sim_takes_input(sim, sim->p2);
+}
+
+static void begin_recording(Replay *replay, const SimState *sim, Uint32 seed, bool multiplayer)
+{
+    replay_begin(replay, seed, multiplayer, SIM_STEP_MS);
+    if (opponent_searches(sim))
+        replay->header.flags |= REPLAY_OPPONENT_INPUT;
+}
+
+/* Closes the recording and writes it to REPLAY_DIR, named by wall-clock time */
+static void save_recording(Replay *replay, const SimState *final)
+{
+    replay_end(replay, final);
+    if (replay->header.ticks == 0)
+        return;
+
+    char path[64];
+    time_t now = time(NULL);
+    size_t n = strftime(path, sizeof(path), REPLAY_DIR "match-%Y%m%d-%H%M%S.smr", localtime(&now));
+    if (n > 0 && replay_save(replay, path))
+        printf("Replay saved to %s (%u ticks, %u bytes)\n", path, (unsigned)replay->header.ticks,
+               (unsigned)(sizeof(ReplayHeader) + replay->header.data_size));
+}
+
+/* Command-line modes (no arguments: the normal menu).
+ * Online versus:
+ *   SMACK! --host PORT [options]       player 1, waits for the other side
+ *   SMACK! --join HOST PORT [options]  player 2
+ * Options: --delay TICKS and --rollback TICKS (the host's delay wins), and
+ * for trying it out on loopback, a bad network applied to what this side
+ * sends: --latency MS (one way), --jitter MS, --loss PERCENT.
+ * Replay playback (hold TAB to fast-forward):
+ *   SMACK! --replay FILE
+ * Developer mode, loose files only and reloaded as they change (not online):
+ *   SMACK! --dev [--replay FILE]
+ * Display, with any of the above: --fps N paces frames to N per second, and
+ * --no-vsync presents without waiting for the display (paced to its refresh
+ * rate unless --fps says otherwise; --fps 0 turns the pacer off).
+ * Single-player opponent: --ai classic (the scripted AI, default) or the
+ * lookahead AI at easy, normal or hard. */
+typedef struct
+{
+    bool netplay;
+    bool host;
+    const char *peer;
+    Uint16 port;
+    int input_delay;
+    int rollback_window;
+    NetConditions conditions;
+    const char *replay_path;
+    bool dev;
+    int target_fps; /* -1: the display's rate without vsync, none with it */
+    bool vsync;
+    AiLevel ai;
+} LaunchOptions;
+
+static bool parse_launch_args(int argc, char *argv[], LaunchOptions *opt)
+{
+    memset(opt, 0, sizeof(*opt));
+    opt->input_delay = NETPLAY_DEFAULT_INPUT_DELAY;
+    opt->rollback_window = NETPLAY_DEFAULT_ROLLBACK;
+    opt->target_fps = -1;
+    opt->vsync = true;
+    int menu_args = 0; /* the only arguments that go with the plain menu */
+
+    for (int i = 1; i < argc; ++i)
+    {
+        bool has_value = i + 1 < argc;
+        if (strcmp(argv[i], "--host") == 0 && has_value)
+        {
+            opt->netplay = opt->host = true;
+            opt->port = (Uint16)atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--join") == 0 && i + 2 < argc)
+        {
+            opt->netplay = true;
+            opt->peer = argv[++i];
+            opt->port = (Uint16)atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--delay") == 0 && has_value)
+            opt->input_delay = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--rollback") == 0 && has_value)
+            opt->rollback_window = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--latency") == 0 && has_value)
+            opt->conditions.latency_ms = (Uint32)atoi(argv[++i]);
+        else if (strcmp(argv[i], "--jitter") == 0 && has_value)
+            opt->conditions.jitter_ms = (Uint32)atoi(argv[++i]);
+        else if (strcmp(argv[i], "--loss") == 0 && has_value)
+            opt->conditions.loss_percent = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--replay") == 0 && has_value)
+            opt->replay_path = argv[++i];
+        else if (strcmp(argv[i], "--dev") == 0)
+            opt->dev = true;
+        else if (strcmp(argv[i], "--fps") == 0 && has_value && atoi(argv[i + 1]) >= 0)
+        {
+            opt->target_fps = atoi(argv[++i]);
+            menu_args += 2;
+        }
+        else if (strcmp(argv[i], "--no-vsync") == 0)
+        {
+            opt->vsync = false;
+            menu_args++;
+        }
+        else if (strcmp(argv[i], "--ai") == 0 && has_value && ai_level_find(argv[i + 1]) >= 0)
+        {
+            opt->ai = (AiLevel)ai_level_find(argv[++i]);
+            menu_args += 2;
+        }
+        else
+            return false;
+    }
+    /* Reloading mid-match would desync the peers */
+    if (opt->netplay && (opt->replay_path || opt->dev))
+        return false;
+    return argc - 1 == menu_args || opt->netplay || opt->replay_path || opt->dev;
+}
+
+/* The session replaces the plain SimState in the arena for online matches */
+static NetplaySession *start_netplay(MatchArena *arena, NetLink link, int side, Uint32 seed,
+                                     int input_delay, int rollback_window)
+{
+    match_arena_reset(arena);
+    NetplaySession *session = (NetplaySession *)match_arena_alloc(arena, sizeof(NetplaySession));
+    if (!session || !netplay_start(session, link, side, seed, input_delay, rollback_window))
+        return NULL;
+    return session;
+}
 
 /* ------------------------------------------------------------------------- */
 int main(int argc, char *argv[])
 {
-    srand(time(NULL));
+    /* No window, renderer or audio: just run AI-vs-AI matches and report */
+    if (argc > 1 && strcmp(argv[1], "--headless") == 0)
+        return headless_main(argc - 1, argv + 1);
+
+    LaunchOptions launch;
+    if (!parse_launch_args(argc, argv, &launch))
+    {
+        fprintf(stderr, "usage: %s [--headless ...] | [--dev] [--replay FILE] | [--host PORT | --join HOST PORT]\n"
+                        "          [--delay TICKS] [--rollback TICKS] [--latency MS] [--jitter MS] [--loss PERCENT]\n"
+                        "          [--fps N] [--no-vsync] [--ai classic|easy|normal|hard]\n",
+                argv[0]);
+        return 1;
+    }
+
+    /* Every match is recorded (and --replay plays one back) through this
+     * buffer; it is too big for the match arena */
+    static Replay replay;
+    if (launch.replay_path && !replay_load(&replay, launch.replay_path))
+        return 1;
+
     /* ---------- SDL / libraries initialisation ---------- */
     if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) != 0)
     {
@@ -30,14 +224,19 @@ int main(int argc, char *argv[])
         SDL_Quit();
         return 1;
     }
-    if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) < 0)
+    if (Mix_OpenAudio(SOUND_FREQUENCY, SOUND_FORMAT, SOUND_CHANNELS, SOUND_CHUNK_SIZE) < 0)
     {
         fprintf(stderr, "Mix_OpenAudio Error: %s\n", Mix_GetError());
         IMG_Quit();
         SDL_Quit();
         return 1;
     }
-    
+
+    /* One mapped file instead of dozens of loose reads, when it has been built.
+     * Developer mode reads the loose files, since those are what gets edited. */
+    if (!launch.dev)
+        asset_pack_open(ASSET_PACK_PATH);
+
     // MODIFIED: Replaced TTF_Init() with our new text_init() function
     if (!text_init("assets/texts/Pixelify_Sans/static/PixelifySans-Medium.ttf", 48)) {
         fprintf(stderr, "Failed to initialize text module.\n");
@@ -47,8 +246,6 @@ int main(int argc, char *argv[])
         return 1;
     }
 
-    sound_init();
-
     /* ---------- window / renderer ---------- */
     SDL_Window *win = SDL_CreateWindow(
         "SMACK!",
@@ -66,7 +263,7 @@ int main(int argc, char *argv[])
     }
 
     SDL_Renderer *ren = SDL_CreateRenderer(
-        win, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+        win, -1, SDL_RENDERER_ACCELERATED | (launch.vsync ? SDL_RENDERER_PRESENTVSYNC : 0));
     if (!ren)
     {
         fprintf(stderr, "SDL_CreateRenderer Error: %s\n", SDL_GetError());
@@ -79,6 +276,11 @@ int main(int argc, char *argv[])
     }
 
     /* ---------- resources ---------- */
+    /* Everything below is decoded on the loader thread in the order queued
+     * (menu first) and uploaded a slice per frame, so the menu is up at once */
+    profiler_init(true); /* before the loader thread records into it */
+    asset_loader_start();
+
     Background *bg = create_background(ren, "assets/textures/intro_screen.bmp", 12, 100);
     Background *map1 = create_background(ren, "assets/textures/autumn.bmp", 12, 100);
     Background *map2 = create_background(ren, "assets/textures/cherry_blossom.bmp", 7, 100);
@@ -105,19 +307,66 @@ int main(int argc, char *argv[])
                                      "assets/textures/map3us-export.bmp",
                                      "assets/textures/map3s-export.bmp");
 
+    /* Pack every fighter sheet into shared atlas pages */
+    const char *const extra_fighter_sheets[] = {"assets/textures/jmph258w516.bmp"};
+    texture_atlas_build_dir(ren, FIGHTER_TEXTURE_DIR, extra_fighter_sheets, 1);
+
+    sound_init();
+    if (launch.dev)
+        hot_reload_start("assets");
+
     /* ---------- game-state variables ---------- */
-    Player *player = NULL;
-    Player2 *player2 = NULL;  
-    MultiFight *mulfight = NULL; 
-    SingleFight *sinfight = NULL;
-    Enemy *enemy = NULL;
+    static Uint8 match_memory[MATCH_ARENA_SIZE];
+    MatchArena match_arena;
+    match_arena_init(&match_arena, match_memory, sizeof(match_memory));
+    SimState *sim = NULL;
+    AiSearch search; /* --ai: the lookahead opponent */
+
+    /* Online versus: the session owns the SimState (sim points into it) */
+    static NetUdp udp;
+    static NetLinkSim net_link;
+    NetplayHandshake handshake;
+    NetplaySession *session = NULL;
+    bool net_waiting = false; /* sheets loaded, looking for the other side */
+
+    bool recording = false;
+    Uint32 recorded_tick = 0; /* online: confirmed ticks written so far */
+    ReplayCursor playback;     /* --replay */
+    bool playback_done = false;
 
     Background *current_background = bg;
     bool game_started = false;
+    bool match_pending = false; /* map picked, waiting for loads to finish */
     bool is_multiplayer = false;
 
-    Uint32 last_time = SDL_GetTicks();
-    Uint32 delta_time;
+    Uint64 counter_hz = SDL_GetPerformanceFrequency();
+    Uint64 last_counter = SDL_GetPerformanceCounter();
+    Uint32 accumulator = 0; /* us */
+
+    /* Without vsync nothing else would stop the loop spinning a core */
+    int target_fps = launch.target_fps;
+    if (target_fps < 0 && !launch.vsync)
+    {
+        SDL_DisplayMode mode;
+        target_fps = SDL_GetWindowDisplayMode(win, &mode) == 0 && mode.refresh_rate > 0 ? mode.refresh_rate : 60;
+    }
+    FramePacer pacer;
+    frame_pacer_init(&pacer, target_fps > 0 ? target_fps : 0);
+
+    /* Match input from key events, each step taking its share of the frame's */
+    InputBuffer input_p1, input_p2;
+    input_buffer_init(&input_p1, &keymap_p1);
+    input_buffer_init(&input_p2, &keymap_p2);
+
+    /* F3 frame-rate overlay, averaged over half a second */
+    bool show_fps = false;
+    float fps = 0.0f;
+    int fps_frames = 0;
+    Uint32 fps_window_start = SDL_GetTicks();
+    /* F4 per-zone timings and frame-time histogram */
+    bool show_profiler = false;
+    /* F6 hit and hurt boxes */
+    bool show_boxes = false;
 
     /* ---------- UI visibility flags ---------- */
     bool play_button_visible = true;
@@ -131,18 +380,87 @@ int main(int argc, char *argv[])
     SDL_Event e;
     int running = 1;
     sound_play_music("menu");
+
+    if (launch.netplay)
+    {
+        if (SDLNet_Init() != 0)
+        {
+            fprintf(stderr, "SDLNet_Init Error: %s\n", SDLNet_GetError());
+            running = 0;
+        }
+        else if (!net_udp_open(&udp, launch.host ? NULL : launch.peer, launch.port))
+        {
+            running = 0;
+        }
+        else
+        {
+            /* Always through the simulator: with no conditions it passes straight on */
+            net_link_sim_init(&net_link, net_udp_link(&udp), launch.conditions, (Uint32)time(NULL));
+            netplay_handshake_init(&handshake, net_link_sim_link(&net_link), launch.host, (Uint32)time(NULL),
+                                   launch.input_delay);
+
+            /* Straight into versus on the first map */
+            play_button_visible = false;
+            is_multiplayer = true;
+            current_background = map1;
+            sound_play_music("map1");
+            match_pending = true;
+        }
+    }
+    if (launch.replay_path)
+    {
+        play_button_visible = false;
+        is_multiplayer = (replay.header.flags & REPLAY_MULTIPLAYER) != 0;
+        current_background = map1;
+        sound_play_music("map1");
+        match_pending = true;
+    }
     while (running)
     {
-        /* delta-time calculation */
+        /* frame-time accumulation */
         Uint32 current_time = SDL_GetTicks();
-        delta_time = current_time - last_time;
-        last_time = current_time;
+        Uint64 counter = SDL_GetPerformanceCounter();
+        Uint64 frame_ticks = counter - last_counter;
+        last_counter = counter;
+        Uint32 frame_time = SIM_STEP_US * SIM_MAX_STEPS_PER_FRAME;
+        if (frame_ticks < counter_hz)
+            frame_time = (Uint32)(frame_ticks * 1000000 / counter_hz);
+        if (frame_time > SIM_STEP_US * SIM_MAX_STEPS_PER_FRAME)
+            frame_time = SIM_STEP_US * SIM_MAX_STEPS_PER_FRAME;
+        accumulator += frame_time;
+
+        fps_frames++;
+        if (current_time - fps_window_start >= 500)
+        {
+            fps = fps_frames * 1000.0f / (float)(current_time - fps_window_start);
+            fps_frames = 0;
+            fps_window_start = current_time;
+        }
 
         /* events */
+        ProfScope scope = prof_begin(PROF_EVENTS);
         while (SDL_PollEvent(&e))
         {
             if (e.type == SDL_QUIT)
                 running = 0;
+            input_buffer_event(&input_p1, &e);
+            input_buffer_event(&input_p2, &e);
+            if (e.type == SDL_KEYDOWN && e.key.keysym.scancode == SDL_SCANCODE_F3 && !e.key.repeat)
+                show_fps = !show_fps;
+            if (e.type == SDL_KEYDOWN && e.key.keysym.scancode == SDL_SCANCODE_F4 && !e.key.repeat)
+                show_profiler = !show_profiler;
+            if (e.type == SDL_KEYDOWN && e.key.keysym.scancode == SDL_SCANCODE_F6 && !e.key.repeat)
+                show_boxes = !show_boxes;
+            if (e.type == SDL_KEYDOWN && e.key.keysym.scancode == SDL_SCANCODE_F5 && !e.key.repeat)
+            {
+                if (profiler_tracing())
+                {
+                    profiler_trace_stop();
+                    printf("Trace written to %s\n", TRACE_PATH);
+                }
+                else
+                    profiler_trace_start(TRACE_PATH);
+            }
 
             if (play_button_visible)
                 handle_button_event(play, &e);
@@ -157,62 +475,142 @@ int main(int argc, char *argv[])
             if (map3_btn_visible)
                 handle_button_event(map3_btn, &e);
         }
+        prof_end(scope);
 
         const Uint8 *keystate = SDL_GetKeyboardState(NULL);
 
-        // ADDED: Main game logic is now split between "fight ongoing" and "fight over"
-        bool fight_is_over = (is_multiplayer && mulfight && mulfight->fight_over) || (!is_multiplayer && sinfight && sinfight->fight_over);
+        scope = prof_begin(PROF_LOADER);
+        asset_loader_pump(ren, LOAD_BUDGET_US);
+        if (launch.dev)
+            hot_reload_poll(ren, sim ? &sim->fighters : NULL);
+        prof_end(scope);
+        scope = prof_begin(PROF_NET);
+        if (launch.netplay)
+            net_link_sim_pump(&net_link, current_time);
 
-        if (game_started && !fight_is_over)
+        if (net_waiting && netplay_handshake_poll(&handshake, current_time))
+        {
+            net_waiting = false;
+            game_started = true;
+            session = start_netplay(&match_arena, handshake.link, launch.host ? 0 : 1, handshake.seed,
+                                    handshake.input_delay, launch.rollback_window);
+            sim = session ? &session->sim : NULL;
+            if (session)
+            {
+                replay_begin(&replay, handshake.seed, true, SIM_STEP_MS);
+                recording = true;
+                recorded_tick = 0;
+            }
+        }
+        else if (net_waiting && handshake.refused)
         {
-            // --- LOGIC FOR WHEN FIGHT IS ONGOING ---
-            if (player) handle_player_input(player, keystate);
-            if (player2) handle_player2_input(player2, keystate);
-            if (enemy) handle_enemy_ai(enemy, player, delta_time);
+            net_waiting = false;
+            running = 0;
+        }
+        prof_end(scope);
 
-            if (player) update_player(player, delta_time);
-            if (player2) update_player2(player2, delta_time);
-            if (enemy) update_enemy(enemy, delta_time);
+        /* ---------- fixed-step simulation ---------- */
+        scope = prof_begin(PROF_SIM);
+        while (accumulator >= SIM_STEP_US)
+        {
+            accumulator -= SIM_STEP_US;
+            if (!game_started || !sim)
+                continue;
+            /* This step covers game time up to here; the frame's last one
+             * also takes the keys pressed since the frame began */
+            Uint32 step_end = accumulator >= SIM_STEP_US ? current_time - accumulator / 1000 : SDL_GetTicks();
+
+            if (session)
+            {
+                /* Online each side plays on the player 1 keys; no restart */
+                netplay_step(session, input_buffer_step(&input_p1, step_end));
 
-            if (mulfight) update_multi_fight(mulfight, player, player2, delta_time);
-            if (sinfight) update_single_fight(sinfight, player, enemy, delta_time);
-        }
-        else if (game_started && fight_is_over)
-        { 
-            if (player) update_player(player, delta_time);
-            if (player2) update_player2(player2, delta_time);
-            if (enemy) update_enemy(enemy, delta_time); 
-            if (is_multiplayer && mulfight)
+                /* Only confirmed ticks go into the replay */
+                Uint32 confirmed = netplay_confirmed_tick(session);
+                for (; recorded_tick < confirmed; ++recorded_tick)
+                {
+                    FighterInput tick_inputs[MAX_FIGHTERS];
+                    netplay_tick_inputs(session, recorded_tick, tick_inputs);
+                    replay_record(&replay, tick_inputs[sim->p1], tick_inputs[sim->p2]);
+                }
+                continue;
+            }
+
+            if (launch.replay_path)
             {
-                handle_multi_fight_game_over_input(mulfight, keystate);
-                if (mulfight->restart_requested)
+                int steps = keystate[SDL_SCANCODE_TAB] ? REPLAY_FAST_FORWARD : 1;
+                for (int i = 0; i < steps && !playback_done; ++i)
                 {
-                    destroy_player(player);
-                    destroy_player2(player2);
-                    destroy_multi_fight(mulfight);
-                    player = create_player(ren, 50, 375);
-                    player2 = create_player2(ren, 800, 375);
-                    mulfight = create_multi_fight();
+                    FighterInput tick_inputs[MAX_FIGHTERS] = {0};
+                    if (replay_cursor_next(&playback, &tick_inputs[sim->p1], &tick_inputs[sim->p2]))
+                    {
+                        sim_step(sim, tick_inputs);
+                        continue;
+                    }
+                    playback_done = true;
+                    if ((replay.header.flags & REPLAY_HAS_CHECKSUM) && sim_checksum(sim) != replay.header.final_checksum)
+                        fprintf(stderr, "Replay: diverged from the recording by tick %u\n", (unsigned)sim->clock.tick);
+                    else
+                        printf("Replay finished at tick %u\n", (unsigned)sim->clock.tick);
                 }
+                continue;
             }
-            else if (!is_multiplayer && sinfight)
+
+            /* Both keymaps every step (the scripted AI ignores its slot), or
+             * the lookahead AI deciding for the opponent */
+            FighterInput inputs[MAX_FIGHTERS] = {0};
+            inputs[sim->p1] = input_buffer_step(&input_p1, step_end);
+            if (opponent_searches(sim))
+                inputs[sim->p2] = ai_search_input(&search, sim);
+            else
+                inputs[sim->p2] = input_buffer_step(&input_p2, step_end);
+            bool fight_was_over = sim_fight_over(sim);
+            if (recording)
+                replay_record(&replay, inputs[sim->p1], sim_takes_input(sim, sim->p2) ? inputs[sim->p2] : 0);
+            sim_step(sim, inputs);
+
+            if (fight_was_over)
             {
-                handle_single_fight_game_over_input(sinfight, keystate);
-                if (sinfight->restart_requested)
+                bool restart;
+                if (sim->multiplayer)
+                {
+                    handle_multi_fight_game_over_input(&sim->multi, keystate);
+                    restart = sim->multi.restart_requested;
+                }
+                else
+                {
+                    handle_single_fight_game_over_input(&sim->single, keystate);
+                    restart = sim->single.restart_requested;
+                }
+                if (restart)
                 {
-                    destroy_player(player);
-                    destroy_enemy(enemy);
-                    destroy_single_fight(sinfight);
-                    player = create_player(ren, 50, 375);
-                    enemy = create_enemy(ren, 800, 375);
-                    sinfight = create_single_fight();
+                    /* The request is menu state, not part of the recorded match */
+                    sim->multi.restart_requested = sim->single.restart_requested = false;
+                    bool multiplayer = sim->multiplayer;
+                    save_recording(&replay, sim);
+                    Uint32 seed = (Uint32)time(NULL);
+                    sim = start_match(&match_arena, multiplayer, seed, launch.ai, &search);
+                    begin_recording(&replay, sim, seed, multiplayer);
                 }
             }
         }
+        /* Buffers no step read: keep only the keys' current state */
+        if (!game_started || !sim || launch.replay_path)
+            input_buffer_flush(&input_p1);
+        if (!game_started || !sim || launch.replay_path || session || opponent_searches(sim))
+            input_buffer_flush(&input_p2);
+
+        prof_end(scope);
+
+        /* how far we are between the last two simulation states */
+        float alpha = (float)accumulator / (float)SIM_STEP_US;
 
         /* background update (always runs) */
+        scope = prof_begin(PROF_BACKGROUND);
         update_background(current_background);
-        
+        prof_end(scope);
+
+
         /* ---------- menu navigation ---------- */
         if (play_button_visible && play_button_clicked(play))
         {
@@ -242,82 +640,144 @@ int main(int argc, char *argv[])
         {
             sound_play_music("map1");
             map1_btn_visible = map2_btn_visible = map3_btn_visible = false;
-            current_background = map1; game_started = true;
-            player = create_player(ren, 50, 375);
-            if (is_multiplayer) {
-                player2 = create_player2(ren, 800, 375);
-                mulfight = create_multi_fight();
-            } else {
-                enemy = create_enemy(ren, 800, 375);
-                sinfight = create_single_fight();
-            }
+            current_background = map1; match_pending = true;
         }
         if (map2_btn_visible && map2_button_clicked(map2_btn))
         {
             sound_play_music("map2");
             map1_btn_visible = map2_btn_visible = map3_btn_visible = false;
-            current_background = map2; game_started = true;
-            player = create_player(ren, 50, 375);
-            if (is_multiplayer) {
-                player2 = create_player2(ren, 800, 375);
-                mulfight = create_multi_fight();
-            } else {
-                enemy = create_enemy(ren, 800, 375);
-                sinfight = create_single_fight();
-            }
+            current_background = map2; match_pending = true;
         }
         if (map3_btn_visible && map3_button_clicked(map3_btn))
         {
             sound_play_music("map3");
             map1_btn_visible = map2_btn_visible = map3_btn_visible = false;
-            current_background = map3; game_started = true;
-            player = create_player(ren, 50, 375);
-            if (is_multiplayer) {
-                player2 = create_player2(ren, 800, 375);
-                mulfight = create_multi_fight();
-            } else {
-                enemy = create_enemy(ren, 800, 375);
-                sinfight = create_single_fight();
+            current_background = map3; match_pending = true;
+        }
+
+        /* the fighters' sheets must be resident so creating them never blocks */
+        if (match_pending && asset_loader_idle())
+        {
+            match_pending = false;
+            bool sheets_ok = fighter_assets_acquire(ren);
+            if (launch.netplay)
+            {
+                net_waiting = sheets_ok;
+            }
+            else if (launch.replay_path)
+            {
+                game_started = true;
+                match_arena_reset(&match_arena);
+                sim = (SimState *)match_arena_alloc(&match_arena, sizeof(SimState));
+                if (sim && (!sheets_ok || !replay_start_sim(&replay, sim)))
+                    sim = NULL;
+                replay_cursor_init(&playback, &replay);
+            }
+            else
+            {
+                game_started = true;
+                Uint32 seed = (Uint32)time(NULL);
+                if (sheets_ok)
+                    sim = start_match(&match_arena, is_multiplayer, seed, launch.ai, &search);
+                begin_recording(&replay, sim, seed, is_multiplayer);
+                recording = sim != NULL;
             }
         }
 
         /* ---------- rendering ---------- */
         SDL_RenderClear(ren);
+        scope = prof_begin(PROF_BACKGROUND);
         render_background(ren, current_background);
-
-        if (game_started) {
-            sound_play_effects(player, player2, enemy);
-            if (player) render_player(ren, player);
-            if (player2) render_player2(ren, player2);
-            if (enemy) render_enemy(ren, enemy);
-            if (mulfight) render_health_bars(ren, mulfight);
-            if (sinfight) health_bars(ren, sinfight);
+        prof_end(scope);
+
+        if (game_started && sim) {
+            scope = prof_begin(PROF_SOUND);
+            sound_play_effects(&sim->fighters);
+            prof_end(scope);
+            scope = prof_begin(PROF_RENDER_FIGHTERS);
+            fighter_store_render(ren, &sim->fighters, alpha);
+            if (show_boxes)
+                frame_data_render_boxes(ren, &sim->fighters);
+            prof_end(scope);
+
+            scope = prof_begin(PROF_HUD);
+            if (sim->multiplayer) render_health_bars(ren, &sim->multi);
+            else health_bars(ren, &sim->single);
 
             // ADDED: Render the game over screen on top if the fight is over
-            if (is_multiplayer && mulfight && mulfight->fight_over) {
-                render_game_over_screen_multi(ren, mulfight->winner);
-            } else if (!is_multiplayer && sinfight && sinfight->fight_over) {
-                render_game_over_screen_single(ren, sinfight->winner);
+            /* Online, only once both sides' inputs have confirmed it */
+            const SimState *result = session ? netplay_state_at(session, netplay_confirmed_tick(session)) : sim;
+            if (result && result->multiplayer && result->multi.fight_over) {
+                render_game_over_screen_multi(ren, result->multi.winner);
+            } else if (result && !result->multiplayer && result->single.fight_over) {
+                render_game_over_screen_single(ren, result->single.winner);
             }
-        } else {
+            prof_end(scope);
+        } else if (!game_started) {
              if (play_button_visible) render_button(ren, play);
              if (single_play_button_visible) render_button(ren, single_play);
              if (multi_play_button_visible) render_button(ren, multi_play);
              if (map1_btn_visible) render_button(ren, map1_btn);
              if (map2_btn_visible) render_button(ren, map2_btn);
              if (map3_btn_visible) render_button(ren, map3_btn);
+             if (match_pending) render_loading_screen(ren, asset_loader_progress());
+             if (net_waiting) render_waiting_screen(ren, launch.host ? "Waiting for player 2" : "Connecting");
+        }
+
+        if (show_fps)
+        {
+            FramePacerStats pacing;
+            frame_pacer_stats(&pacer, &pacing);
+            render_fps_counter(ren, fps);
+            render_frame_pacing(ren, &pacing);
+        }
+        if (show_fps && session)
+            render_netplay_stats(ren, session->input_delay * SIM_STEP_MS,
+                                 (int)session->stats.last_rollback * SIM_STEP_MS,
+                                 (int)session->stats.max_rollback * SIM_STEP_MS, session->stats.stalls);
+        if (show_profiler)
+        {
+            ProfilerStats stats;
+            profiler_stats(&stats);
+            render_profiler_overlay(ren, &stats, profiler_tracing());
         }
 
+        scope = prof_begin(PROF_PRESENT);
+        sprite_batch_end_frame(); /* the frame's draw calls are issued here */
+        prof_end(scope);
+        scope = prof_begin(PROF_PACE);
+        frame_pacer_wait(&pacer);
+        prof_end(scope);
+        scope = prof_begin(PROF_PRESENT);
         SDL_RenderPresent(ren);
+        prof_end(scope);
+        profiler_frame();
     }
 
     /* ---------- cleanup ---------- */
-    if (player) destroy_player(player);
-    if (player2) destroy_player2(player2);
-    if (enemy) destroy_enemy(enemy); 
-    if (sinfight) destroy_single_fight(sinfight);
-    if (mulfight) destroy_multi_fight(mulfight);
+    if (target_fps > 0)
+    {
+        FramePacerStats pacing;
+        frame_pacer_stats(&pacer, &pacing);
+        printf("Frame pacing at %d FPS: mean %.2f ms, jitter %.2f ms, worst miss %.2f ms (last %d frames)\n",
+               target_fps, pacing.mean_ms, pacing.jitter_ms, pacing.worst_ms, pacing.frames);
+    }
+    if (profiler_tracing())
+    {
+        profiler_trace_stop();
+        printf("Trace written to %s\n", TRACE_PATH);
+    }
+    asset_loader_stop(ren); /* hands any in-flight assets to their owners */
+    if (recording)
+        save_recording(&replay, session ? netplay_state_at(session, recorded_tick) : sim);
+    fighter_assets_release(); /* the match itself lives in the static arena */
+    if (launch.netplay)
+    {
+        net_udp_close(&udp);
+        SDLNet_Quit();
+    }
 
+    hot_reload_stop();
     sound_quit();
     destroy_button(play);
     destroy_button(single_play);
@@ -330,11 +790,14 @@ int main(int argc, char *argv[])
     destroy_background(map1);
     destroy_background(map2);
     destroy_background(map3);
+    asset_cache_clear();
+    texture_atlas_destroy_all();
 
+    text_quit(); // ADDED: Cleanup for the text module (its glyph atlases are textures)
     SDL_DestroyRenderer(ren);
     SDL_DestroyWindow(win);
-    text_quit(); // ADDED: Cleanup for the text module
     Mix_CloseAudio();
+    asset_pack_close(); /* font and music streams read from it until here */
     IMG_Quit();
     SDL_Quit();
     return 0;
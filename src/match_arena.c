@@ -0,0 +1,39 @@
+#include "match_arena.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+void match_arena_init(MatchArena *arena, void *memory, size_t size)
+{
+    /* Align the start so every allocation is aligned, not just offsets */
+    size_t pad = (MATCH_ARENA_ALIGN - (size_t)((uintptr_t)memory % MATCH_ARENA_ALIGN)) % MATCH_ARENA_ALIGN;
+    if (pad > size)
+        pad = size;
+    arena->base = (Uint8 *)memory + pad;
+    arena->size = size - pad;
+    arena->used = 0;
+    arena->high_water = 0;
+}
+
+void *match_arena_alloc(MatchArena *arena, size_t size)
+{
+    size_t start = (arena->used + MATCH_ARENA_ALIGN - 1) & ~(size_t)(MATCH_ARENA_ALIGN - 1);
+    if (start > arena->size || size > arena->size - start)
+    {
+        fprintf(stderr, "Match arena: out of space (%lu of %lu bytes used, %lu requested)\n",
+                (unsigned long)arena->used, (unsigned long)arena->size, (unsigned long)size);
+        return NULL;
+    }
+    arena->used = start + size;
+    if (arena->used > arena->high_water)
+        arena->high_water = arena->used;
+
+    void *p = arena->base + start;
+    memset(p, 0, size);
+    return p;
+}
+
+void match_arena_reset(MatchArena *arena)
+{
+    arena->used = 0;
+}
@@ -0,0 +1,100 @@
+#include "net_link.h"
+#include <string.h>
+
+/* ---------- In-memory pipe ---------- */
+
+void net_pipe_init(NetPipe *pipe)
+{
+    memset(pipe, 0, sizeof(*pipe));
+}
+
+static bool pipe_send(void *ctx, const Uint8 *data, int len)
+{
+    NetPipe *pipe = ((NetPipeEnd *)ctx)->out;
+    if (pipe->count == NET_PIPE_SLOTS || len > NET_MAX_PACKET)
+        return false;
+    int slot = (pipe->head + pipe->count) % NET_PIPE_SLOTS;
+    memcpy(pipe->data[slot], data, (size_t)len);
+    pipe->len[slot] = len;
+    pipe->count++;
+    return true;
+}
+
+static int pipe_recv(void *ctx, Uint8 *data, int cap)
+{
+    NetPipe *pipe = ((NetPipeEnd *)ctx)->in;
+    if (pipe->count == 0)
+        return 0;
+    int len = pipe->len[pipe->head];
+    if (len > cap)
+        len = cap;
+    memcpy(data, pipe->data[pipe->head], (size_t)len);
+    pipe->head = (pipe->head + 1) % NET_PIPE_SLOTS;
+    pipe->count--;
+    return len;
+}
+
+NetLink net_pipe_link(NetPipeEnd *end)
+{
+    return (NetLink){pipe_send, pipe_recv, end};
+}
+
+/* ---------- Bad-network simulator ---------- */
+
+void net_link_sim_init(NetLinkSim *sim, NetLink inner, NetConditions conditions, Uint32 seed)
+{
+    memset(sim, 0, sizeof(*sim));
+    sim->inner = inner;
+    sim->conditions = conditions;
+    sim_rng_seed(&sim->rng, seed);
+}
+
+void net_link_sim_pump(NetLinkSim *sim, Uint32 now)
+{
+    sim->now = now;
+    /* Unordered queue: jitter lets a later packet overtake an earlier one */
+    int i = 0;
+    while (i < sim->count)
+    {
+        if ((Sint32)(now - sim->due[i]) < 0)
+        {
+            ++i;
+            continue;
+        }
+        sim->inner.send(sim->inner.ctx, sim->data[i], sim->len[i]);
+        int last = --sim->count;
+        sim->due[i] = sim->due[last];
+        sim->len[i] = sim->len[last];
+        memcpy(sim->data[i], sim->data[last], (size_t)sim->len[last]);
+    }
+}
+
+static bool sim_send(void *ctx, const Uint8 *data, int len)
+{
+    NetLinkSim *sim = (NetLinkSim *)ctx;
+    const NetConditions *c = &sim->conditions;
+    if (c->loss_percent > 0 && (int)sim_rng_range(&sim->rng, 0, 99) < c->loss_percent)
+        return true; /* "sent", never arrives */
+    if (sim->count == NET_SIM_QUEUE || len > NET_MAX_PACKET)
+        return false;
+
+    Uint32 delay = c->latency_ms + (c->jitter_ms ? sim_rng_range(&sim->rng, 0, c->jitter_ms) : 0);
+    int slot = sim->count++;
+    sim->due[slot] = sim->now + delay;
+    sim->len[slot] = len;
+    memcpy(sim->data[slot], data, (size_t)len);
+    if (delay == 0)
+        net_link_sim_pump(sim, sim->now);
+    return true;
+}
+
+static int sim_recv(void *ctx, Uint8 *data, int cap)
+{
+    NetLinkSim *sim = (NetLinkSim *)ctx;
+    return sim->inner.recv(sim->inner.ctx, data, cap);
+}
+
+NetLink net_link_sim_link(NetLinkSim *sim)
+{
+    return (NetLink){sim_send, sim_recv, sim};
+}
@@ -0,0 +1,80 @@
+#include "net_udp.h"
+#include <stdio.h>
+#include <string.h>
+
+bool net_udp_open(NetUdp *udp, const char *peer_host, Uint16 port)
+{
+    memset(udp, 0, sizeof(*udp));
+    if (peer_host)
+    {
+        if (SDLNet_ResolveHost(&udp->peer, peer_host, port) != 0)
+        {
+            fprintf(stderr, "Netplay: cannot resolve %s: %s\n", peer_host, SDLNet_GetError());
+            return false;
+        }
+        udp->has_peer = true;
+    }
+
+    udp->socket = SDLNet_UDP_Open(peer_host ? 0 : port);
+    if (!udp->socket)
+    {
+        fprintf(stderr, "Netplay: cannot open UDP port %u: %s\n", (unsigned)(peer_host ? 0 : port), SDLNet_GetError());
+        return false;
+    }
+    udp->packet = SDLNet_AllocPacket(NET_MAX_PACKET);
+    if (!udp->packet)
+    {
+        fprintf(stderr, "Netplay: cannot allocate a packet: %s\n", SDLNet_GetError());
+        SDLNet_UDP_Close(udp->socket);
+        udp->socket = NULL;
+        return false;
+    }
+    return true;
+}
+
+void net_udp_close(NetUdp *udp)
+{
+    if (udp->packet)
+        SDLNet_FreePacket(udp->packet);
+    if (udp->socket)
+        SDLNet_UDP_Close(udp->socket);
+    memset(udp, 0, sizeof(*udp));
+}
+
+static bool udp_send(void *ctx, const Uint8 *data, int len)
+{
+    NetUdp *udp = (NetUdp *)ctx;
+    if (!udp->has_peer || len > udp->packet->maxlen)
+        return false;
+    memcpy(udp->packet->data, data, (size_t)len);
+    udp->packet->len = len;
+    udp->packet->address = udp->peer;
+    return SDLNet_UDP_Send(udp->socket, -1, udp->packet) == 1;
+}
+
+static int udp_recv(void *ctx, Uint8 *data, int cap)
+{
+    NetUdp *udp = (NetUdp *)ctx;
+    while (SDLNet_UDP_Recv(udp->socket, udp->packet) == 1)
+    {
+        IPaddress from = udp->packet->address;
+        if (!udp->has_peer)
+        {
+            udp->peer = from;
+            udp->has_peer = true;
+        }
+        else if (from.host != udp->peer.host || from.port != udp->peer.port)
+        {
+            continue; /* somebody else */
+        }
+        int len = udp->packet->len < cap ? udp->packet->len : cap;
+        memcpy(data, udp->packet->data, (size_t)len);
+        return len;
+    }
+    return 0;
+}
+
+NetLink net_udp_link(NetUdp *udp)
+{
+    return (NetLink){udp_send, udp_recv, udp};
+}
@@ -0,0 +1,345 @@
+#include "netplay.h"
+#include "frame_data.h"
+#include <stdio.h>
+#include <string.h>
+
+#define NETPLAY_VERSION 2
+
+/* Message types (first byte; the second is NETPLAY_VERSION) */
+#define MSG_HELLO 1 /* definitions hash */
+#define MSG_START 2 /* seed, input delay, definitions hash */
+#define MSG_INPUT 3
+
+#define HELLO_SIZE 6
+#define START_SIZE 11
+
+/* MSG_INPUT: header, then one byte per input */
+#define INPUT_HEADER_SIZE 24
+#define INPUTS_PER_PACKET (NET_MAX_PACKET - INPUT_HEADER_SIZE)
+
+#define HELLO_INTERVAL_MS 250
+/* How often the peers compare how far ahead each one runs */
+#define SYNC_INTERVAL 30
+
+#define NO_TICK 0xFFFFFFFFu
+
+/* ---------- Wire format (little-endian) ---------- */
+
+static void put_u32(Uint8 *p, Uint32 v)
+{
+    p[0] = (Uint8)v;
+    p[1] = (Uint8)(v >> 8);
+    p[2] = (Uint8)(v >> 16);
+    p[3] = (Uint8)(v >> 24);
+}
+
+static Uint32 get_u32(const Uint8 *p)
+{
+    return (Uint32)p[0] | (Uint32)p[1] << 8 | (Uint32)p[2] << 16 | (Uint32)p[3] << 24;
+}
+
+static void send_start(NetLink link, Uint32 seed, int input_delay)
+{
+    Uint8 msg[START_SIZE] = {MSG_START, NETPLAY_VERSION};
+    put_u32(msg + 2, seed);
+    msg[6] = (Uint8)input_delay;
+    put_u32(msg + 7, fighter_data_hash());
+    link.send(link.ctx, msg, sizeof(msg));
+}
+
+/* Peers with different fighter definitions or frame data would desync on
+ * the first hit, so neither starts */
+static bool same_definitions(const Uint8 *hash)
+{
+    if (get_u32(hash) == fighter_data_hash())
+        return true;
+    fprintf(stderr, "Netplay: the other side has different fighter definitions or frame data "
+                    "(%s, %s); not starting.\n",
+            FIGHTER_DEFS_PATH, FRAME_DATA_PATH);
+    return false;
+}
+
+/* ---------- Session ---------- */
+
+bool netplay_start(NetplaySession *s, NetLink link, int local_side, Uint32 seed,
+                   int input_delay, int rollback_window)
+{
+    memset(s, 0, sizeof(*s));
+    if (input_delay < 0 || input_delay > NETPLAY_MAX_INPUT_DELAY ||
+        rollback_window < 1 || rollback_window > NETPLAY_MAX_ROLLBACK)
+    {
+        fprintf(stderr, "Netplay: input delay must be 0-%d and the rollback window 1-%d ticks.\n",
+                NETPLAY_MAX_INPUT_DELAY, NETPLAY_MAX_ROLLBACK);
+        return false;
+    }
+    s->link = link;
+    s->local_side = local_side;
+    s->seed = seed;
+    s->input_delay = input_delay;
+    s->rollback_window = rollback_window;
+
+    /* The first `input_delay` ticks have no inputs on either side */
+    s->local_next = (Uint32)input_delay;
+    s->remote_next = (Uint32)input_delay;
+    s->first_wrong = NO_TICK;
+    return sim_start(&s->sim, true, seed, SIM_STEP_MS);
+}
+
+static FighterInput predicted_remote(const NetplaySession *s)
+{
+    /* Whatever they were last known to hold */
+    if (s->remote_next == 0)
+        return 0;
+    return s->inputs[(s->remote_next - 1) % NETPLAY_INPUT_RING][1 - s->local_side];
+}
+
+static void simulate_tick(NetplaySession *s)
+{
+    Uint32 t = s->tick;
+    int remote = 1 - s->local_side;
+    const FighterInput *row = s->inputs[t % NETPLAY_INPUT_RING];
+
+    sim_save(&s->sim, &s->snapshots[t % NETPLAY_MAX_ROLLBACK]);
+
+    FighterInput side[2];
+    side[s->local_side] = row[s->local_side];
+    side[remote] = t < s->remote_next ? row[remote] : predicted_remote(s);
+    s->used[t % NETPLAY_INPUT_RING] = side[remote];
+
+    FighterInput inputs[MAX_FIGHTERS] = {0};
+    inputs[s->sim.p1] = side[0];
+    inputs[s->sim.p2] = side[1];
+    sim_step(&s->sim, inputs);
+    s->tick++;
+}
+
+static void rollback(NetplaySession *s)
+{
+    if (s->first_wrong >= s->tick)
+    {
+        s->first_wrong = NO_TICK;
+        return;
+    }
+    Uint32 end = s->tick;
+    Uint32 depth = end - s->first_wrong;
+    sim_restore(&s->sim, &s->snapshots[s->first_wrong % NETPLAY_MAX_ROLLBACK]);
+    s->tick = s->first_wrong;
+    s->first_wrong = NO_TICK;
+    while (s->tick < end)
+        simulate_tick(s);
+
+    s->stats.rollbacks++;
+    s->stats.resimulated += depth;
+    s->stats.last_rollback = depth;
+    if (depth > s->stats.max_rollback)
+        s->stats.max_rollback = depth;
+}
+
+Uint32 netplay_confirmed_tick(const NetplaySession *s)
+{
+    return s->remote_next < s->tick ? s->remote_next : s->tick;
+}
+
+const SimState *netplay_state_at(const NetplaySession *s, Uint32 tick)
+{
+    if (tick > netplay_confirmed_tick(s) || s->tick - tick > NETPLAY_MAX_ROLLBACK)
+        return NULL;
+    /* A correction not yet re-simulated makes everything after it stale */
+    if (s->first_wrong < tick)
+        return NULL;
+    return tick == s->tick ? &s->sim : &s->snapshots[tick % NETPLAY_MAX_ROLLBACK];
+}
+
+void netplay_tick_inputs(const NetplaySession *s, Uint32 tick, FighterInput inputs[MAX_FIGHTERS])
+{
+    memset(inputs, 0, MAX_FIGHTERS * sizeof(FighterInput));
+    inputs[s->sim.p1] = s->inputs[tick % NETPLAY_INPUT_RING][0];
+    inputs[s->sim.p2] = s->inputs[tick % NETPLAY_INPUT_RING][1];
+}
+
+static void receive_inputs(NetplaySession *s, const Uint8 *msg, int len)
+{
+    if (len < INPUT_HEADER_SIZE)
+        return;
+    Uint32 remote_tick = get_u32(msg + 2);
+    Uint32 ack = get_u32(msg + 6);
+    Uint32 first = get_u32(msg + 10);
+    int count = msg[14];
+    Sint8 advantage = (Sint8)msg[15];
+    Uint32 check_tick = get_u32(msg + 16);
+    Uint32 checksum = get_u32(msg + 20);
+    if (len < INPUT_HEADER_SIZE + count)
+        return;
+
+    /* Packets can arrive out of order: only ever move forward */
+    if ((Sint32)(remote_tick - s->remote_tick) >= 0)
+    {
+        s->remote_tick = remote_tick;
+        s->remote_advantage = advantage;
+    }
+    if ((Sint32)(ack - s->remote_ack) > 0 && ack <= s->local_next)
+        s->remote_ack = ack;
+
+    /* The sender starts at our ack, so there are no gaps to fill */
+    int remote = 1 - s->local_side;
+    Uint32 limit = s->tick + NETPLAY_INPUT_RING - NETPLAY_MAX_ROLLBACK;
+    for (int i = 0; i < count; ++i)
+    {
+        Uint32 t = first + (Uint32)i;
+        if (t != s->remote_next || t >= limit)
+            continue;
+        FighterInput in = msg[INPUT_HEADER_SIZE + i];
+        s->inputs[t % NETPLAY_INPUT_RING][remote] = in;
+        s->remote_next++;
+        if (t < s->tick && s->used[t % NETPLAY_INPUT_RING] != in && t < s->first_wrong)
+            s->first_wrong = t;
+    }
+
+    /* Compare against our own copy of the same confirmed state, if kept */
+    const SimState *mine = netplay_state_at(s, check_tick);
+    if (mine && s->first_wrong == NO_TICK && sim_checksum(mine) != checksum && !s->desynced)
+    {
+        s->desynced = true;
+        fprintf(stderr, "Netplay: desync at tick %u (checksum %08x, peer %08x)\n",
+                (unsigned)check_tick, (unsigned)sim_checksum(mine), (unsigned)checksum);
+    }
+}
+
+static void receive_packets(NetplaySession *s)
+{
+    Uint8 msg[NET_MAX_PACKET];
+    int len;
+    while ((len = s->link.recv(s->link.ctx, msg, sizeof(msg))) > 0)
+    {
+        if (len < 2 || msg[1] != NETPLAY_VERSION)
+            continue;
+        s->stats.packets_received++;
+        switch (msg[0])
+        {
+        case MSG_HELLO:
+            /* Our START got lost; the joining side is still asking */
+            if (s->local_side == 0)
+                send_start(s->link, s->seed, s->input_delay);
+            break;
+        case MSG_INPUT:
+            receive_inputs(s, msg, len);
+            break;
+        }
+    }
+}
+
+static void send_inputs(NetplaySession *s)
+{
+    Uint32 first = s->remote_ack;
+    Uint32 count = s->local_next - first;
+    if (count > INPUTS_PER_PACKET)
+        count = INPUTS_PER_PACKET;
+
+    Sint32 advantage = (Sint32)(s->tick - s->remote_tick);
+    if (advantage > 127)
+        advantage = 127;
+    if (advantage < -128)
+        advantage = -128;
+
+    Uint32 check_tick = netplay_confirmed_tick(s);
+    const SimState *confirmed = netplay_state_at(s, check_tick);
+
+    Uint8 msg[NET_MAX_PACKET] = {MSG_INPUT, NETPLAY_VERSION};
+    put_u32(msg + 2, s->tick);
+    put_u32(msg + 6, s->remote_next);
+    put_u32(msg + 10, first);
+    msg[14] = (Uint8)count;
+    msg[15] = (Uint8)(Sint8)advantage;
+    put_u32(msg + 16, confirmed ? check_tick : NO_TICK);
+    put_u32(msg + 20, confirmed ? sim_checksum(confirmed) : 0);
+    for (Uint32 i = 0; i < count; ++i)
+        msg[INPUT_HEADER_SIZE + i] = s->inputs[(first + i) % NETPLAY_INPUT_RING][s->local_side];
+
+    if (s->link.send(s->link.ctx, msg, INPUT_HEADER_SIZE + (int)count))
+        s->stats.packets_sent++;
+}
+
+/* Both sides see the other as behind by the one-way latency; what is left
+ * after that cancels out is how far this peer really runs ahead */
+static bool should_wait_for_sync(NetplaySession *s)
+{
+    /* At most one step per interval, so it nudges rather than freezes */
+    if (s->tick % SYNC_INTERVAL != 0 || s->tick == s->last_sync_tick)
+        return false;
+    s->last_sync_tick = s->tick;
+    Sint32 local_advantage = (Sint32)(s->tick - s->remote_tick);
+    return (local_advantage - s->remote_advantage) / 2 >= 1;
+}
+
+bool netplay_step(NetplaySession *s, FighterInput local)
+{
+    receive_packets(s);
+    rollback(s);
+
+    bool advance = true;
+    if (s->tick >= s->remote_next + (Uint32)s->rollback_window)
+    {
+        s->stats.stalls++;
+        advance = false;
+    }
+    else if (should_wait_for_sync(s))
+    {
+        s->stats.sync_waits++;
+        advance = false;
+    }
+
+    if (advance)
+    {
+        s->inputs[s->local_next % NETPLAY_INPUT_RING][s->local_side] = local;
+        s->local_next++;
+        simulate_tick(s);
+    }
+    send_inputs(s);
+    return advance;
+}
+
+/* ---------- Handshake ---------- */
+
+void netplay_handshake_init(NetplayHandshake *h, NetLink link, bool host, Uint32 seed, int input_delay)
+{
+    memset(h, 0, sizeof(*h));
+    h->link = link;
+    h->host = host;
+    h->seed = seed;
+    h->input_delay = input_delay;
+}
+
+bool netplay_handshake_poll(NetplayHandshake *h, Uint32 now)
+{
+    if (!h->host && (!h->hello_sent || now - h->last_hello >= HELLO_INTERVAL_MS))
+    {
+        Uint8 hello[HELLO_SIZE] = {MSG_HELLO, NETPLAY_VERSION};
+        put_u32(hello + 2, fighter_data_hash());
+        h->link.send(h->link.ctx, hello, sizeof(hello));
+        h->hello_sent = true;
+        h->last_hello = now;
+    }
+
+    Uint8 msg[NET_MAX_PACKET];
+    int len;
+    while ((len = h->link.recv(h->link.ctx, msg, sizeof(msg))) > 0)
+    {
+        if (len < 2 || msg[1] != NETPLAY_VERSION)
+            continue;
+        if (h->host && msg[0] == MSG_HELLO && len >= HELLO_SIZE)
+        {
+            /* Answered either way, so the joining side finds out too */
+            send_start(h->link, h->seed, h->input_delay);
+            h->refused = !same_definitions(msg + 2);
+            return !h->refused;
+        }
+        if (!h->host && msg[0] == MSG_START && len >= START_SIZE)
+        {
+            h->seed = get_u32(msg + 2);
+            h->input_delay = msg[6];
+            h->refused = !same_definitions(msg + 7);
+            return !h->refused;
+        }
+    }
+    return false;
+}
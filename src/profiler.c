@@ -0,0 +1,230 @@
+#include "profiler.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Power of two. A 60 Hz frame records a few dozen samples, so this is
+ * seconds of slack before an unprofiled stall could lap the reader. */
+#define PROF_RING_SIZE 4096
+
+typedef struct
+{
+    SDL_atomic_t seq; /* index + 1 once written, 0 while being written */
+    Uint32 thread;
+    ProfZone zone;
+    Uint64 start, end;
+} ProfSample;
+
+static const struct
+{
+    const char *name;
+    int depth;
+} zone_info[PROF_ZONE_COUNT] = {
+    [PROF_EVENTS] = {"events", 0},
+    [PROF_LOADER] = {"loader", 0},
+    [PROF_NET] = {"net", 0},
+    [PROF_SIM] = {"sim", 0},
+    [PROF_AI] = {"ai", 1},
+    [PROF_FIGHTERS] = {"fighters", 1},
+    [PROF_FIGHT] = {"fight", 1},
+    [PROF_SEARCH] = {"ai search", 1},
+    [PROF_BACKGROUND] = {"background", 0},
+    [PROF_RENDER_FIGHTERS] = {"draw fighters", 0},
+    [PROF_HUD] = {"hud", 0},
+    [PROF_SOUND] = {"sound", 0},
+    [PROF_PRESENT] = {"present", 0},
+    [PROF_PACE] = {"pace", 0},
+    [PROF_DECODE] = {"decode", 0},
+};
+
+bool profiler_active = false;
+
+static ProfSample ring[PROF_RING_SIZE];
+static SDL_atomic_t ring_head; /* next index to write */
+static Uint32 ring_tail;       /* next index to read (main thread) */
+static Uint32 dropped;
+
+static double ticks_to_ms;
+static Uint64 frame_start;
+
+/* Per-frame history, newest at history_pos - 1 */
+static float zone_history[PROF_HISTORY][PROF_ZONE_COUNT];
+static float frame_history[PROF_HISTORY];
+static int history_pos;
+static int history_count;
+
+static FILE *trace_file;
+static Uint64 trace_origin;
+static bool trace_first;
+
+void profiler_init(bool enabled)
+{
+    profiler_active = enabled;
+    ticks_to_ms = 1000.0 / (double)SDL_GetPerformanceFrequency();
+    frame_start = SDL_GetPerformanceCounter();
+}
+
+void profiler_record(ProfZone zone, Uint64 start, Uint64 end)
+{
+    if (!profiler_active)
+        return;
+    Uint32 index = (Uint32)SDL_AtomicAdd(&ring_head, 1);
+    ProfSample *sample = &ring[index & (PROF_RING_SIZE - 1)];
+
+    /* Mark the slot torn first so a reader that lapped us skips it */
+    SDL_AtomicSet(&sample->seq, 0);
+    SDL_MemoryBarrierRelease();
+    sample->thread = (Uint32)SDL_ThreadID();
+    sample->zone = zone;
+    sample->start = start;
+    sample->end = end;
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&sample->seq, (int)(index + 1));
+}
+
+static void trace_write(const char *name, Uint32 thread, Uint64 start, Uint64 end)
+{
+    if (start < trace_origin)
+        return;
+    double ts = (double)(start - trace_origin) * ticks_to_ms * 1000.0;
+    double dur = (double)(end - start) * ticks_to_ms * 1000.0;
+    fprintf(trace_file, "%s{\"name\":\"%s\",\"cat\":\"smack\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+            trace_first ? "" : ",\n", name, (unsigned)thread, ts, dur);
+    trace_first = false;
+}
+
+/* Folds every finished sample into `totals` (counter ticks per zone) */
+static void drain(Uint64 totals[PROF_ZONE_COUNT])
+{
+    Uint32 head = (Uint32)SDL_AtomicGet(&ring_head);
+    if (head - ring_tail > PROF_RING_SIZE)
+    {
+        dropped += head - ring_tail - PROF_RING_SIZE;
+        ring_tail = head - PROF_RING_SIZE;
+    }
+
+    for (; ring_tail != head; ++ring_tail)
+    {
+        ProfSample *slot = &ring[ring_tail & (PROF_RING_SIZE - 1)];
+        Uint32 seq = (Uint32)SDL_AtomicGet(&slot->seq);
+        if (seq != ring_tail + 1)
+        {
+            if ((Sint32)(seq - (ring_tail + 1)) > 0)
+            {
+                dropped++; /* a writer lapped us since the head was read */
+                continue;
+            }
+            break; /* still being written: pick it up next frame */
+        }
+        SDL_MemoryBarrierAcquire();
+        ProfSample copy = *slot;
+        SDL_MemoryBarrierAcquire();
+        if ((Uint32)SDL_AtomicGet(&slot->seq) != seq)
+        {
+            dropped++;
+            continue;
+        }
+
+        if (copy.zone < PROF_ZONE_COUNT && copy.end >= copy.start)
+        {
+            totals[copy.zone] += copy.end - copy.start;
+            if (trace_file)
+                trace_write(zone_info[copy.zone].name, copy.thread, copy.start, copy.end);
+        }
+    }
+}
+
+void profiler_frame(void)
+{
+    if (!profiler_active)
+        return;
+
+    Uint64 now = SDL_GetPerformanceCounter();
+    Uint64 totals[PROF_ZONE_COUNT] = {0};
+    drain(totals);
+    if (trace_file)
+        trace_write("frame", (Uint32)SDL_ThreadID(), frame_start, now);
+
+    for (int z = 0; z < PROF_ZONE_COUNT; ++z)
+        zone_history[history_pos][z] = (float)((double)totals[z] * ticks_to_ms);
+    frame_history[history_pos] = (float)((double)(now - frame_start) * ticks_to_ms);
+    history_pos = (history_pos + 1) % PROF_HISTORY;
+    if (history_count < PROF_HISTORY)
+        history_count++;
+    frame_start = now;
+}
+
+static int compare_float(const void *a, const void *b)
+{
+    float x = *(const float *)a, y = *(const float *)b;
+    return (x > y) - (x < y);
+}
+
+void profiler_stats(ProfilerStats *stats)
+{
+    memset(stats, 0, sizeof(*stats));
+    stats->frames = history_count;
+    stats->dropped = dropped;
+    if (history_count == 0)
+        return;
+
+    int average = history_count < PROF_AVERAGE_FRAMES ? history_count : PROF_AVERAGE_FRAMES;
+    for (int i = 1; i <= average; ++i)
+    {
+        const float *frame = zone_history[(history_pos - i + PROF_HISTORY) % PROF_HISTORY];
+        for (int z = 0; z < PROF_ZONE_COUNT; ++z)
+            stats->zone_ms[z] += frame[z] / (float)average;
+    }
+
+    float sorted[PROF_HISTORY];
+    for (int i = 0; i < history_count; ++i)
+    {
+        sorted[i] = frame_history[i];
+        int bin = (int)frame_history[i];
+        stats->histogram[bin < PROF_HISTOGRAM_BINS ? bin : PROF_HISTOGRAM_BINS - 1]++;
+    }
+    qsort(sorted, (size_t)history_count, sizeof(float), compare_float);
+    stats->frame_p50 = sorted[(history_count - 1) * 50 / 100];
+    stats->frame_p99 = sorted[(history_count - 1) * 99 / 100];
+    stats->frame_max = sorted[history_count - 1];
+}
+
+const char *profiler_zone_name(ProfZone zone)
+{
+    return zone < PROF_ZONE_COUNT ? zone_info[zone].name : "?";
+}
+
+int profiler_zone_depth(ProfZone zone)
+{
+    return zone < PROF_ZONE_COUNT ? zone_info[zone].depth : 0;
+}
+
+bool profiler_trace_start(const char *path)
+{
+    if (!profiler_active || trace_file)
+        return false;
+    trace_file = fopen(path, "w");
+    if (!trace_file)
+    {
+        fprintf(stderr, "Profiler: can't write %s\n", path);
+        return false;
+    }
+    fputs("[\n", trace_file);
+    trace_origin = SDL_GetPerformanceCounter();
+    trace_first = true;
+    return true;
+}
+
+void profiler_trace_stop(void)
+{
+    if (!trace_file)
+        return;
+    fputs("\n]\n", trace_file);
+    fclose(trace_file);
+    trace_file = NULL;
+}
+
+bool profiler_tracing(void)
+{
+    return trace_file != NULL;
+}
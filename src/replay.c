@@ -0,0 +1,189 @@
+#include "replay.h"
+#include <stdio.h>
+#include <string.h>
+
+#define INPUT_BITS 7
+#define INPUT_MASK ((1u << INPUT_BITS) - 1)
+/* A run needs at most 2 bytes of input and 5 of count */
+#define MAX_RUN_BYTES 7
+
+void replay_begin(Replay *r, Uint32 seed, bool multiplayer, Uint32 step_ms)
+{
+    memset(&r->header, 0, sizeof(r->header));
+    r->header.magic = REPLAY_MAGIC;
+    r->header.version = REPLAY_VERSION;
+    r->header.flags = multiplayer ? REPLAY_MULTIPLAYER : 0;
+    r->header.seed = seed;
+    r->header.step_ms = step_ms;
+    r->run_input = 0;
+    r->run_length = 0;
+}
+
+static void flush_run(Replay *r)
+{
+    if (r->run_length == 0)
+        return;
+    if (r->header.data_size + MAX_RUN_BYTES > REPLAY_MAX_DATA)
+    {
+        r->header.flags |= REPLAY_TRUNCATED;
+        r->run_length = 0;
+        return;
+    }
+
+    Uint8 *p = r->data + r->header.data_size;
+    *p++ = (Uint8)r->run_input;
+    *p++ = (Uint8)(r->run_input >> 8);
+    Uint32 n = r->run_length;
+    while (n >= 0x80)
+    {
+        *p++ = (Uint8)(n | 0x80);
+        n >>= 7;
+    }
+    *p++ = (Uint8)n;
+
+    r->header.data_size = (Uint32)(p - r->data);
+    r->header.ticks += r->run_length;
+    r->run_length = 0;
+}
+
+void replay_record(Replay *r, FighterInput p1, FighterInput p2)
+{
+    if (r->header.flags & REPLAY_TRUNCATED)
+        return;
+    Uint16 word = (Uint16)((p1 & INPUT_MASK) | (p2 & INPUT_MASK) << INPUT_BITS);
+    if (r->run_length > 0 && word != r->run_input)
+        flush_run(r);
+    r->run_input = word;
+    r->run_length++;
+}
+
+void replay_end(Replay *r, const SimState *final)
+{
+    flush_run(r);
+    /* A cut-short replay cannot vouch for the end state */
+    if (final && !(r->header.flags & REPLAY_TRUNCATED))
+    {
+        r->header.final_checksum = sim_checksum(final);
+        r->header.flags |= REPLAY_HAS_CHECKSUM;
+    }
+}
+
+/* The header as stored: each field a little-endian Uint32, in this order */
+#define HEADER_FIELDS 8
+#define HEADER_BYTES (HEADER_FIELDS * 4)
+
+static void header_fields(ReplayHeader *h, Uint32 *fields[HEADER_FIELDS])
+{
+    fields[0] = &h->magic;
+    fields[1] = &h->version;
+    fields[2] = &h->flags;
+    fields[3] = &h->seed;
+    fields[4] = &h->step_ms;
+    fields[5] = &h->ticks;
+    fields[6] = &h->final_checksum;
+    fields[7] = &h->data_size;
+}
+
+bool replay_save(const Replay *r, const char *path)
+{
+    SDL_RWops *rw = SDL_RWFromFile(path, "wb");
+    if (!rw)
+    {
+        fprintf(stderr, "Replay: cannot write %s\n", path);
+        return false;
+    }
+    ReplayHeader header = r->header;
+    Uint32 *fields[HEADER_FIELDS];
+    header_fields(&header, fields);
+    bool ok = true;
+    for (int i = 0; i < HEADER_FIELDS; ++i)
+        ok = ok && SDL_WriteLE32(rw, *fields[i]) == 1;
+    ok = ok && SDL_RWwrite(rw, r->data, 1, r->header.data_size) == r->header.data_size;
+    if (SDL_RWclose(rw) != 0)
+        ok = false;
+    if (!ok)
+        fprintf(stderr, "Replay: failed writing %s\n", path);
+    return ok;
+}
+
+bool replay_load(Replay *r, const char *path)
+{
+    SDL_RWops *rw = SDL_RWFromFile(path, "rb");
+    if (!rw)
+    {
+        fprintf(stderr, "Replay: cannot open %s\n", path);
+        return false;
+    }
+    /* SDL_ReadLE32 cannot report a short read, so check the size first */
+    bool ok = SDL_RWsize(rw) >= HEADER_BYTES;
+    if (ok)
+    {
+        Uint32 *fields[HEADER_FIELDS];
+        header_fields(&r->header, fields);
+        for (int i = 0; i < HEADER_FIELDS; ++i)
+            *fields[i] = SDL_ReadLE32(rw);
+    }
+    ok = ok && r->header.magic == REPLAY_MAGIC && r->header.version == REPLAY_VERSION &&
+         r->header.data_size <= REPLAY_MAX_DATA && r->header.step_ms > 0 &&
+         SDL_RWread(rw, r->data, 1, r->header.data_size) == r->header.data_size;
+    SDL_RWclose(rw);
+    if (!ok)
+    {
+        fprintf(stderr, "Replay: %s is not a version %d replay\n", path, REPLAY_VERSION);
+        return false;
+    }
+    r->run_input = 0;
+    r->run_length = 0;
+    return true;
+}
+
+void replay_cursor_init(ReplayCursor *c, const Replay *r)
+{
+    memset(c, 0, sizeof(*c));
+    c->replay = r;
+}
+
+bool replay_cursor_next(ReplayCursor *c, FighterInput *p1, FighterInput *p2)
+{
+    const Replay *r = c->replay;
+    if (c->tick >= r->header.ticks)
+        return false;
+
+    if (c->remaining == 0)
+    {
+        Uint32 size = r->header.data_size;
+        if (c->offset + 2 > size)
+            return false;
+        c->input = (Uint16)(r->data[c->offset] | r->data[c->offset + 1] << 8);
+        c->offset += 2;
+
+        Uint32 n = 0;
+        for (int shift = 0;; shift += 7)
+        {
+            if (c->offset >= size || shift > 28)
+                return false;
+            Uint8 byte = r->data[c->offset++];
+            n |= (Uint32)(byte & 0x7F) << shift;
+            if (!(byte & 0x80))
+                break;
+        }
+        if (n == 0)
+            return false;
+        c->remaining = n;
+    }
+
+    *p1 = (FighterInput)(c->input & INPUT_MASK);
+    *p2 = (FighterInput)((c->input >> INPUT_BITS) & INPUT_MASK);
+    c->remaining--;
+    c->tick++;
+    return true;
+}
+
+bool replay_start_sim(const Replay *r, SimState *sim)
+{
+    if (!sim_start(sim, (r->header.flags & REPLAY_MULTIPLAYER) != 0, r->header.seed, r->header.step_ms))
+        return false;
+    if (r->header.flags & REPLAY_OPPONENT_INPUT)
+        sim_opponent_by_input(sim);
+    return true;
+}
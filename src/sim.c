@@ -0,0 +1,135 @@
+#include "sim.h"
+#include "profiler.h"
+#include <string.h>
+
+#define P1_START_X 50
+#define P2_START_X 800
+#define START_Y 375
+
+/* A knockout plays out at quarter speed for this long (real time) */
+#define KO_SLOW_SCALE (GAME_CLOCK_SCALE_ONE / 4)
+#define KO_SLOW_MS 1500
+
+bool sim_start(SimState *sim, bool multiplayer, Uint32 seed, Uint32 step_ms)
+{
+    /* Zero the padding too, so equal states compare and checksum equal */
+    memset(sim, 0, sizeof(*sim));
+    game_clock_init(&sim->clock, step_ms);
+    sim_rng_seed(&sim->rng, seed);
+    sim->multiplayer = multiplayer;
+
+    /* Player 1 on the left; on the right, player 2 or the AI hunting player 1 */
+    fighter_store_init(&sim->fighters);
+    sim->p1 = fighter_spawn(&sim->fighters, ARCHETYPE_PLAYER, (FighterController){CONTROL_PLAYER, -1},
+                            P1_START_X, START_Y, sim->clock.now);
+    if (multiplayer)
+    {
+        sim->p2 = fighter_spawn(&sim->fighters, ARCHETYPE_PLAYER, (FighterController){CONTROL_PLAYER, -1},
+                                P2_START_X, START_Y, sim->clock.now);
+        multi_fight_init(&sim->multi);
+    }
+    else
+    {
+        sim->p2 = fighter_spawn(&sim->fighters, ARCHETYPE_ENEMY, (FighterController){CONTROL_AI, (Sint8)sim->p1},
+                                P2_START_X, START_Y, sim->clock.now);
+        single_fight_init(&sim->single);
+    }
+    return sim->p1 >= 0 && sim->p2 >= 0;
+}
+
+/* A zone only if `profiled` */
+static ProfScope zone_begin(ProfZone zone, bool profiled)
+{
+    if (profiled)
+        return prof_begin(zone);
+    return (ProfScope){0, zone};
+}
+
+static void step(SimState *sim, const FighterInput inputs[MAX_FIGHTERS], bool profiled)
+{
+    game_clock_advance(&sim->clock);
+
+    if (sim_fight_over(sim))
+    {
+        fighter_store_update(&sim->fighters, &sim->clock);
+        return;
+    }
+
+    ProfScope scope = zone_begin(PROF_AI, profiled);
+    fighter_store_control(&sim->fighters, inputs, &sim->rng, sim->clock.now);
+    prof_end(scope);
+
+    scope = zone_begin(PROF_FIGHTERS, profiled);
+    fighter_store_update(&sim->fighters, &sim->clock);
+    prof_end(scope);
+
+    scope = zone_begin(PROF_FIGHT, profiled);
+    if (sim->multiplayer)
+        update_multi_fight(&sim->multi, &sim->fighters, sim->p1, sim->p2, &sim->clock);
+    else
+        update_single_fight(&sim->single, &sim->fighters, sim->p1, sim->p2, &sim->clock);
+    prof_end(scope);
+
+    if (sim_fight_over(sim))
+        game_clock_set_scale(&sim->clock, KO_SLOW_SCALE, KO_SLOW_MS / sim->clock.step_ms);
+}
+
+void sim_step(SimState *sim, const FighterInput inputs[MAX_FIGHTERS])
+{
+    step(sim, inputs, true);
+}
+
+void sim_lookahead_step(SimState *sim, const FighterInput inputs[MAX_FIGHTERS])
+{
+    step(sim, inputs, false);
+}
+
+void sim_opponent_by_input(SimState *sim)
+{
+    if (!sim->multiplayer)
+        sim->fighters.controller[sim->p2].kind = CONTROL_PLAYER;
+}
+
+bool sim_takes_input(const SimState *sim, int id)
+{
+    return id >= 0 && id < sim->fighters.count && sim->fighters.controller[id].kind == CONTROL_PLAYER;
+}
+
+bool sim_fight_over(const SimState *sim)
+{
+    return sim->multiplayer ? sim->multi.fight_over : sim->single.fight_over;
+}
+
+int sim_winner(const SimState *sim)
+{
+    return sim->multiplayer ? sim->multi.winner : sim->single.winner;
+}
+
+int sim_health(const SimState *sim, int side)
+{
+    if (sim->multiplayer)
+        return side == 0 ? sim->multi.fighter1.health : sim->multi.fighter2.health;
+    return side == 0 ? sim->single.fighter1.health : sim->single.fighter2.health;
+}
+
+void sim_save(const SimState *sim, SimState *snapshot)
+{
+    memcpy(snapshot, sim, sizeof(*snapshot));
+}
+
+void sim_restore(SimState *sim, const SimState *snapshot)
+{
+    memcpy(sim, snapshot, sizeof(*sim));
+}
+
+Uint32 sim_checksum(const SimState *sim)
+{
+    const Uint8 *bytes = (const Uint8 *)sim;
+    Uint32 hash = 2166136261u;
+    for (size_t i = 0; i < sizeof(*sim); ++i)
+    {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
@@ -0,0 +1,24 @@
+#include "sim_rng.h"
+
+void sim_rng_seed(SimRng *rng, Uint32 seed)
+{
+    /* Scramble so nearby seeds diverge at once; xorshift must not start at 0 */
+    Uint32 x = seed * 2654435761u + 0x9E3779B9u;
+    x ^= x >> 16;
+    rng->state = x ? x : 0x9E3779B9u;
+}
+
+Uint32 sim_rng_next(SimRng *rng)
+{
+    /* xorshift32 */
+    Uint32 x = rng->state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return rng->state = x;
+}
+
+Uint32 sim_rng_range(SimRng *rng, Uint32 lo, Uint32 hi)
+{
+    return lo + sim_rng_next(rng) % (hi - lo + 1);
+}
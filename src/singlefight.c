@@ -1,230 +1,162 @@
 #include "singlefight.h"
+#include "sprite_batch.h"
+#include "frame_data.h"
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <math.h>
 #include <stdbool.h>
 
 /* Tunables Mirrored from multifight.c */
-#define ATTACK_RANGE 200.0f
-#define DOWN_ATTACK_RANGE 50.0f
-#define VERTICAL_RANGE 100.0f
 #define ALLOWED_OVERLAP 150
 
 /* ---- Setup / teardown ---- */
-SingleFight *create_single_fight(void)
+void single_fight_init(SingleFight *fight)
 {
-    SingleFight *fight = (SingleFight *)malloc(sizeof(SingleFight));
-    if (!fight)
-    {
-        fprintf(stderr, "Failed to allocate memory for SingleFight\n");
-        return NULL;
-    }
-
-    fight->fighter1 = (Warrior *)calloc(1, sizeof(Warrior));
-    fight->fighter2 = (Warrior *)calloc(1, sizeof(Warrior));
-    if (!fight->fighter1 || !fight->fighter2)
-    {
-        free(fight->fighter1);
-        free(fight);
-        return NULL;
-    }
-
-    fight->fighter1->health = MAX_HEALTH;
-    fight->fighter2->health = MAX_HEALTH;
-
-    fight->fight_over = false;
-    fight->winner = 0;
-    fight->restart_requested = false;
-    return fight;
-}
-
-void destroy_single_fight(SingleFight *fight)
-{
-    if (!fight)
-        return;
-    free(fight->fighter1);
-    free(fight->fighter2);
-    free(fight);
+    memset(fight, 0, sizeof(*fight));
+    fight->fighter1.health = MAX_HEALTH;
+    fight->fighter2.health = MAX_HEALTH;
 }
 
 /* ---- Update ---- */
-void update_single_fight(SingleFight *fight, Player *p1, Enemy *en, Uint32 delta_time)
+void update_single_fight(SingleFight *fight, FighterStore *f, int p1, int en, const GameClock *clock)
 {
-    if (!fight || !p1 || !en || fight->fight_over)
+    if (!fight || p1 < 0 || en < 0 || fight->fight_over)
         return;
+    Uint32 now = clock->now;
 
     // Use player's dynamic frame width for hitbox, matching multifight's corrected logic
-    fight->fighter1->hitbox.x = (int)p1->x;
-    fight->fighter1->hitbox.y = (int)p1->y;
-    fight->fighter1->hitbox.w = 250;
-    fight->fighter1->hitbox.h = (p1->state == PLAYER_SLIDE) ? 0 : 150;
+    fight->fighter1.hitbox.x = (int)f->x[p1];
+    fight->fighter1.hitbox.y = (int)f->y[p1];
+    fight->fighter1.hitbox.w = 250;
+    fight->fighter1.hitbox.h = (f->state[p1] == FIGHTER_SLIDE) ? 0 : 150;
+
+    fight->fighter2.hitbox.x = (int)f->x[en];
+    fight->fighter2.hitbox.y = (int)f->y[en];
+    fight->fighter2.hitbox.w = 250;
+    fight->fighter2.hitbox.h = 150;
 
-    fight->fighter2->hitbox.x = (int)en->x;
-    fight->fighter2->hitbox.y = (int)en->y;
-    fight->fighter2->hitbox.w = 250;
-    fight->fighter2->hitbox.h = 150;
+    /* Hurt timers stand still through hitstop, like the fighters' own */
+    if (f->flags[p1] & FIGHTER_FROZEN)
+        fight->fighter1.hurt_start_time += clock->delta_ms;
+    if (f->flags[en] & FIGHTER_FROZEN)
+        fight->fighter2.hurt_start_time += clock->delta_ms;
 
-    collision(fight, p1, en);
-    combat(fight, p1, en);
+    collision(fight, f, p1, en);
+    combat(fight, f, p1, en, now);
 
-    fighter1_state(fight->fighter1, p1, delta_time);
-    update_enemy_state(fight->fighter2, en, delta_time);
+    fighter1_state(&fight->fighter1, f, p1, now);
+    update_enemy_state(&fight->fighter2, f, en, now);
 
     if (!fight->fight_over)
     {
-        if (fight->fighter1->is_dead)
+        if (fight->fighter1.is_dead)
         {
             fight->winner = 2;
             fight->fight_over = true;
-            fight->fight_end_time = SDL_GetTicks();
+            fight->fight_end_time = now;
         }
-        else if (fight->fighter2->is_dead)
+        else if (fight->fighter2.is_dead)
         {
             fight->winner = 1;
             fight->fight_over = true;
-            set_player_state(p1, PLAYER_PRAY); // Player prays on victory
-            fight->fight_end_time = SDL_GetTicks();
+            fighter_set_state(f, p1, FIGHTER_PRAY, now); // Player prays on victory
+            fight->fight_end_time = now;
         }
     }
 }
 
-void collision(SingleFight *fight, Player *p1, Enemy *en)
+void collision(SingleFight *fight, FighterStore *f, int p1, int en)
 {
-    SDL_Rect *b1 = &fight->fighter1->hitbox;
-    SDL_Rect *b2 = &fight->fighter2->hitbox;
+    SDL_Rect *b1 = &fight->fighter1.hitbox;
+    SDL_Rect *b2 = &fight->fighter2.hitbox;
 
     if (!SDL_HasIntersection(b1, b2))
         return;
 
-    int overlap_x = (p1->x < en->x) ? (b1->x + b1->w) - b2->x : (b2->x + b2->w) - b1->x;
+    int overlap_x = (f->x[p1] < f->x[en]) ? (b1->x + b1->w) - b2->x : (b2->x + b2->w) - b1->x;
     if (overlap_x <= ALLOWED_OVERLAP)
         return;
 
-    bool p1Right = p1->velocity_x > 0, p1Left = p1->velocity_x < 0;
-    bool enRight = en->velocity_x > 0, enLeft = en->velocity_x < 0;
+    bool p1Right = f->velocity_x[p1] > 0, p1Left = f->velocity_x[p1] < 0;
+    bool enRight = f->velocity_x[en] > 0, enLeft = f->velocity_x[en] < 0;
 
     bool towards_each_other =
-        (p1->x < en->x && p1Right && enLeft) ||
-        (p1->x > en->x && p1Left && enRight);
+        (f->x[p1] < f->x[en] && p1Right && enLeft) ||
+        (f->x[p1] > f->x[en] && p1Left && enRight);
 
     float push = (float)(overlap_x - ALLOWED_OVERLAP);
 
     if (towards_each_other)
     {
-        p1->x += (p1->x < en->x ? -push * 0.5f : push * 0.5f);
-        en->x += (p1->x < en->x ? push * 0.5f : -push * 0.5f);
-        p1->velocity_x = en->velocity_x = 0;
+        f->x[p1] += (f->x[p1] < f->x[en] ? -push * 0.5f : push * 0.5f);
+        f->x[en] += (f->x[p1] < f->x[en] ? push * 0.5f : -push * 0.5f);
+        f->velocity_x[p1] = f->velocity_x[en] = 0;
     }
-    else if (p1->velocity_x != 0 && en->velocity_x == 0)
+    else if (f->velocity_x[p1] != 0 && f->velocity_x[en] == 0)
     {
-        p1->x += (p1->x < en->x ? -push : push);
-        p1->velocity_x = 0;
+        f->x[p1] += (f->x[p1] < f->x[en] ? -push : push);
+        f->velocity_x[p1] = 0;
     }
-    else if (en->velocity_x != 0 && p1->velocity_x == 0)
+    else if (f->velocity_x[en] != 0 && f->velocity_x[p1] == 0)
     {
-        en->x += (en->x < p1->x ? -push : push);
-        en->velocity_x = 0;
+        f->x[en] += (f->x[en] < f->x[p1] ? -push : push);
+        f->velocity_x[en] = 0;
     }
 
-    if (p1->x < 0) p1->x = 0;
-    if (en->x < 0) en->x = 0;
+    if (f->x[p1] < 0) f->x[p1] = 0;
+    if (f->x[en] < 0) f->x[en] = 0;
 
     // Use dynamic width for boundary checks
-    int r1 = 1280 - (int)p1->frame_width;
-    int r2 = 1280 - (int)en->frame_width;
-    if (p1->x > r1) p1->x = r1;
-    if (en->x > r2) en->x = r2;
+    int r1 = 1280 - (int)f->frame_width[p1];
+    int r2 = 1280 - (int)f->frame_width[en];
+    if (f->x[p1] > r1) f->x[p1] = r1;
+    if (f->x[en] > r2) f->x[en] = r2;
 
 
-    b1->x = (int)p1->x;
-    b2->x = (int)en->x;
+    b1->x = (int)f->x[p1];
+    b2->x = (int)f->x[en];
 }
 
 /* ---- Hit Detection Logic (Mirrored from multifight.c) ---- */
-static bool facing_p1(Player *a, Enemy *d)
-{
-    return (a->direction == FACING_RIGHT && a->x < d->x) ||
-           (a->direction == FACING_LEFT && a->x > d->x);
-}
-
-static bool p1_normal_attack_hits(Player *attacker, Enemy *defender)
-{
-    float dx = fabsf(attacker->x - defender->x);
-    float dy = fabsf(attacker->y - defender->y);
-    if (dy > VERTICAL_RANGE)
-        return false;
-    return (dx <= ATTACK_RANGE && facing_p1(attacker, defender));
-}
-
-static bool p1_down_attack_hits(Player *attacker, Enemy *defender)
-{
-    if (attacker->on_ground || attacker->y > defender->y || fabsf(attacker->y - defender->y) > VERTICAL_RANGE)
-    {
-        return false;
-    }
-    float dx = fabsf(attacker->x - defender->x);
-    return (dx <= DOWN_ATTACK_RANGE);
-}
-
-// MODIFIED: This function now properly separates attack checks based on the attacker's state.
-bool player1_attack_hit(Player *attacker, Enemy *defender)
-{
-    if (attacker->state == PLAYER_ATTACKING)
-    {
-        return p1_normal_attack_hits(attacker, defender);
-    }
-    else if (attacker->state == PLAYER_DOWN_ATTACK)
-    {
-        return p1_down_attack_hits(attacker, defender);
-    }
-    return false;
-}
-
-bool check_enemy_attack_hit(Enemy *attacker, Player *defender)
+static bool facing(const FighterStore *f, int a, int d)
 {
-    float attack_range = 200.0f;
-    float dx = fabsf(attacker->x - defender->x);
-    float dy = fabsf(attacker->y - defender->y);
-
-    bool facing_correct = (attacker->direction == R && attacker->x < defender->x) ||
-                          (attacker->direction == L && attacker->x > defender->x);
-
-    return (dx <= attack_range && dy <= VERTICAL_RANGE && facing_correct);
+    return (f->direction[a] == FACING_RIGHT && f->x[a] < f->x[d]) ||
+           (f->direction[a] == FACING_LEFT && f->x[a] > f->x[d]);
 }
 
 /* ---- Combat Logic (Mirrored from multifight.c) ---- */
-void combat(SingleFight *fight, Player *p1, Enemy *en)
+void combat(SingleFight *fight, FighterStore *f, int p1, int en, Uint32 now)
 {
-    if (fight->fighter1->is_dead || fight->fighter2->is_dead)
+    if (fight->fighter1.is_dead || fight->fighter2.is_dead)
         return;
 
     /* Player attacks Enemy */
-    if (p1->is_attacking &&
-        !fight->fighter2->is_hurt && !fight->fighter2->is_dead &&
-        player1_attack_hit(p1, en))
+    if ((f->flags[p1] & FIGHTER_IS_ATTACKING) && !(f->flags[p1] & FIGHTER_HIT_LANDED) &&
+        !fight->fighter2.is_hurt && !fight->fighter2.is_dead &&
+        frame_data_attack_hits(f, p1, en))
     {
-        bool enemy_facing =
-            ((p1->x < en->x && en->direction == L) ||
-             (p1->x > en->x && en->direction == R));
-        bool blocked = en->is_blocking && enemy_facing;
+        f->flags[p1] |= FIGHTER_HIT_LANDED;
+        bool blocked = (f->flags[en] & FIGHTER_IS_BLOCKING) && facing(f, en, p1);
 
         if (blocked)
         {
-            set_player_state(p1, PLAYER_BLOCK_HURT);
+            fighter_set_state(f, p1, FIGHTER_BLOCK_HURT, now);
         }
         else
         {
-            apply_damage_to_enemy(fight->fighter2, en, ATTACK_DAMAGE);
+            apply_damage_to_warrior(&fight->fighter2, f, en, ATTACK_DAMAGE, now);
         }
+        fighter_impact(f, p1, en, blocked);
     }
 
     /* Enemy attacks Player */
-    if (en->is_attacking &&
-        !fight->fighter1->is_hurt && !fight->fighter1->is_dead &&
-        check_enemy_attack_hit(en, p1))
+    if ((f->flags[en] & FIGHTER_IS_ATTACKING) && !(f->flags[en] & FIGHTER_HIT_LANDED) &&
+        !fight->fighter1.is_hurt && !fight->fighter1.is_dead &&
+        frame_data_attack_hits(f, en, p1))
     {
-        // A slide is invulnerable to the enemy's attack.
-        bool slide_invulnerable = (p1->state == PLAYER_SLIDE);
+        // A slide is invulnerable to the enemy's attack, unless it is a down attack.
+        bool slide_invulnerable = (f->state[p1] == FIGHTER_SLIDE && f->state[en] != FIGHTER_DOWN_ATTACK);
 
         if(slide_invulnerable)
         {
@@ -232,10 +164,8 @@ void combat(SingleFight *fight, Player *p1, Enemy *en)
         }
         else
         {
-            bool p1_facing =
-                ((en->x < p1->x && p1->direction == FACING_LEFT) ||
-                 (en->x > p1->x && p1->direction == FACING_RIGHT));
-            bool blocked = p1->is_blocking && p1_facing;
+            f->flags[en] |= FIGHTER_HIT_LANDED;
+            bool blocked = (f->flags[p1] & FIGHTER_IS_BLOCKING) && facing(f, p1, en);
 
             if (blocked)
             {
@@ -243,14 +173,15 @@ void combat(SingleFight *fight, Player *p1, Enemy *en)
             }
             else
             {
-                damage_to_player1(fight->fighter1, p1, ATTACK_DAMAGE);
+                apply_damage_to_warrior(&fight->fighter1, f, p1, ATTACK_DAMAGE, now);
             }
+            fighter_impact(f, en, p1, blocked);
         }
     }
 }
 
 /* ---- Damage & timers ---- */
-void damage_to_player1(Warrior *fighter, Player *player, int damage)
+void apply_damage_to_warrior(Warrior *fighter, FighterStore *f, int id, int damage, Uint32 now)
 {
     fighter->health -= damage;
     if (fighter->health < 0) fighter->health = 0;
@@ -258,68 +189,48 @@ void damage_to_player1(Warrior *fighter, Player *player, int damage)
     if (fighter->health == 0)
     {
         fighter->is_dead = true;
-        fighter->death_start_time = SDL_GetTicks();
-        set_player_state(player, PLAYER_DEATH);
+        fighter->death_start_time = now;
+        fighter_set_state(f, id, FIGHTER_DEATH, now);
     }
     else
     {
         fighter->is_hurt = true;
-        fighter->hurt_start_time = SDL_GetTicks();
-        set_player_state(player, PLAYER_HURT);
-    }
-}
-
-void apply_damage_to_enemy(Warrior *fighter, Enemy *enemy, int damage)
-{
-    fighter->health -= damage;
-    if (fighter->health < 0) fighter->health = 0;
-
-    if (fighter->health == 0)
-    {
-        fighter->is_dead = true;
-        fighter->death_start_time = SDL_GetTicks();
-        set_enemy_state(enemy, ENEMY_DEATH);
-    }
-    else
-    {
-        fighter->is_hurt = true;
-        fighter->hurt_start_time = SDL_GetTicks();
-        set_enemy_state(enemy, ENEMY_HURT);
+        fighter->hurt_start_time = now;
+        fighter_set_state(f, id, FIGHTER_HURT, now);
     }
 }
 
 // MODIFIED: This function now includes the attack animation timer logic from multifight.c
-void fighter1_state(Warrior *fighter, Player *player, Uint32 delta_time)
+void fighter1_state(Warrior *fighter, FighterStore *f, int p1, Uint32 now)
 {
-    Uint32 now = SDL_GetTicks();
-    
+    bool on_ground = f->flags[p1] & FIGHTER_ON_GROUND;
+
     // Attack animation timer
-    if (player->is_attacking && (now - player->attack_start_time >= player->attack_duration))
+    if ((f->flags[p1] & FIGHTER_IS_ATTACKING) && (now - f->attack_start_time[p1] >= fighter_archetypes[f->archetype[p1]].attack_duration))
     {
-        player->is_attacking = false;
-        if (player->state == PLAYER_ATTACKING || player->state == PLAYER_DOWN_ATTACK || player->state == PLAYER_BLOCK_HURT)
+        f->flags[p1] &= ~FIGHTER_IS_ATTACKING;
+        if (f->state[p1] == FIGHTER_ATTACKING || f->state[p1] == FIGHTER_DOWN_ATTACK || f->state[p1] == FIGHTER_BLOCK_HURT)
         {
-            set_player_state(player, player->on_ground ? PLAYER_IDLE : PLAYER_JUMPING);
+            fighter_set_state(f, p1, on_ground ? FIGHTER_IDLE : FIGHTER_JUMPING, now);
         }
     }
 
     // Hurt timer
-    if (fighter->is_hurt && now - fighter->hurt_start_time >= HURT_ANIMATION_DURATION)
+    if (fighter->is_hurt && now - fighter->hurt_start_time >= SINGLE_HURT_ANIMATION_DURATION)
     {
         fighter->is_hurt = false;
-        if (player->state == PLAYER_HURT)
-            set_player_state(player, player->on_ground ? PLAYER_IDLE : PLAYER_JUMPING);
+        if (f->state[p1] == FIGHTER_HURT)
+            fighter_set_state(f, p1, on_ground ? FIGHTER_IDLE : FIGHTER_JUMPING, now);
     }
 }
 
-void update_enemy_state(Warrior *fighter, Enemy *enemy, Uint32 delta_time)
+void update_enemy_state(Warrior *fighter, FighterStore *f, int en, Uint32 now)
 {
-    Uint32 now = SDL_GetTicks();
-    if (fighter->is_hurt && now - fighter->hurt_start_time >= HURT_ANIMATION_DURATION)
+    if (fighter->is_hurt && now - fighter->hurt_start_time >= SINGLE_HURT_ANIMATION_DURATION)
     {
         fighter->is_hurt = false;
-        if (enemy->state == ENEMY_HURT)
-            set_enemy_state(enemy, ENEMY_IDLE);
+        if (f->state[en] == FIGHTER_HURT)
+            fighter_set_state(f, en, FIGHTER_IDLE, now);
     }
 }
 
@@ -329,26 +240,21 @@ void health_bars(SDL_Renderer *renderer, SingleFight *fight)
         return;
 
     int bar_width = 400, bar_height = 30, bar_y = 20;
+    SDL_Color back = {100, 0, 0, 255}, health = {0, 255, 0, 255}, border = {255, 255, 255, 255};
+
+    SDL_FRect p1_bg = {20, bar_y, bar_width, bar_height};
+    SDL_FRect p1_health = {20, bar_y, (bar_width * fight->fighter1.health) / MAX_HEALTH, bar_height};
+
+    sprite_batch_fill(renderer, &p1_bg, back);
+    sprite_batch_fill(renderer, &p1_health, health);
+    sprite_batch_outline(renderer, &p1_bg, border);
+
+    SDL_FRect p2_bg = {1280 - bar_width - 20, bar_y, bar_width, bar_height};
+    SDL_FRect p2_health = {1280 - bar_width - 20, bar_y, (bar_width * fight->fighter2.health) / MAX_HEALTH, bar_height};
 
-    SDL_Rect p1_bg = {20, bar_y, bar_width, bar_height};
-    SDL_Rect p1_health = {20, bar_y, (bar_width * fight->fighter1->health) / MAX_HEALTH, bar_height};
-
-    SDL_SetRenderDrawColor(renderer, 100, 0, 0, 255);
-    SDL_RenderFillRect(renderer, &p1_bg);
-    SDL_SetRenderDrawColor(renderer, 0, 255, 0, 255);
-    SDL_RenderFillRect(renderer, &p1_health);
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
-    SDL_RenderDrawRect(renderer, &p1_bg);
-
-    SDL_Rect p2_bg = {1280 - bar_width - 20, bar_y, bar_width, bar_height};
-    SDL_Rect p2_health = {1280 - bar_width - 20, bar_y, (bar_width * fight->fighter2->health) / MAX_HEALTH, bar_height};
-
-    SDL_SetRenderDrawColor(renderer, 100, 0, 0, 255);
-    SDL_RenderFillRect(renderer, &p2_bg);
-    SDL_SetRenderDrawColor(renderer, 0, 255, 0, 255);
-    SDL_RenderFillRect(renderer, &p2_health);
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
-    SDL_RenderDrawRect(renderer, &p2_bg);
+    sprite_batch_fill(renderer, &p2_bg, back);
+    sprite_batch_fill(renderer, &p2_health, health);
+    sprite_batch_outline(renderer, &p2_bg, border);
 }
 void handle_single_fight_game_over_input(SingleFight *fight, const Uint8 *keystate)
 {
@@ -1,4 +1,6 @@
 #include "sound.h"
+#include "asset_loader.h"
+#include "asset_pack.h"
 #include <string.h>
 #include <stdio.h>
 
@@ -9,6 +11,22 @@ static Mix_Music *music_map2 = NULL;
 static Mix_Music *music_map3 = NULL;
 static Mix_Music *menu_music = NULL;
 
+// Music files and the slot each one is loaded into
+typedef struct {
+    const char* name; // as passed to sound_play_music
+    const char* path;
+    Mix_Music** slot;
+} MusicLoad;
+
+static const MusicLoad music_loads[] = {
+    {"menu", "assets/sounds/assets_sounds_fire.mp3", &menu_music},
+    {"map1", "assets/sounds/assets_sounds_ambient.mp3", &music_map1},
+    {"map2", "assets/sounds/assets_sounds_ambient.mp3", &music_map2},
+    {"map3", "assets/sounds/assets_sounds_ambient.mp3", &music_map3},
+};
+#define MUSIC_COUNT (int)(sizeof(music_loads) / sizeof(music_loads[0]))
+static const MusicLoad* music_playing = NULL;
+
 // Sound Effects
 static Mix_Chunk *sfx_attack = NULL;
 static Mix_Chunk *sfx_jump = NULL;
@@ -16,9 +34,24 @@ static Mix_Chunk *sfx_hurt = NULL;
 static Mix_Chunk *sfx_death = NULL;
 static Mix_Chunk *sfx_struck = NULL;
 
+// Effect files and the slot each one is loaded into
+typedef struct {
+    const char* path;
+    Mix_Chunk** slot;
+} SfxLoad;
+
+static const SfxLoad sfx_loads[] = {
+    {"assets/sounds/attack.wav", &sfx_attack},
+    {"assets/sounds/jmp.wav", &sfx_jump},
+    {"assets/sounds/assets_sounds_lighthurt.wav", &sfx_hurt},
+    {"assets/sounds/assets_sounds_death.wav", &sfx_death},
+    {"assets/sounds/assets_sounds_sword4.wav", &sfx_struck},
+};
+#define SFX_COUNT (int)(sizeof(sfx_loads) / sizeof(sfx_loads[0]))
+
 // --- Helper Functions ---
 static Mix_Music* load_music(const char* path) {
-    Mix_Music* music = Mix_LoadMUS(path);
+    Mix_Music* music = Mix_LoadMUS_RW(asset_pack_rw(path), 1);
     if (!music) {
         fprintf(stderr, "Failed to load music %s! Mix_Error: %s\n", path, Mix_GetError());
     }
@@ -26,13 +59,33 @@ static Mix_Music* load_music(const char* path) {
 }
 
 static Mix_Chunk* load_sfx(const char* path) {
-    Mix_Chunk* chunk = Mix_LoadWAV(path);
+    // Packed effects are pre-decoded for the device format; play them
+    // straight out of the mapping if the device matches.
+    const AssetPackEntry* e = asset_pack_find(path);
+    int freq, channels;
+    Uint16 format;
+    if (e && e->kind == PACK_ENTRY_PCM && Mix_QuerySpec(&freq, &format, &channels) &&
+        (Uint32)freq == e->w && (Uint32)channels == e->h && format == e->format) {
+        return Mix_QuickLoad_RAW((Uint8*)asset_pack_data(e), e->size);
+    }
+
+    Mix_Chunk* chunk = Mix_LoadWAV_RW(asset_pack_rw(path), 1);
     if (!chunk) {
         fprintf(stderr, "Failed to load SFX %s! Mix_Error: %s\n", path, Mix_GetError());
     }
     return chunk;
 }
 
+// Asset loader callbacks: decode on the worker, publish on the main thread
+static void sfx_loaded(void* user, void* asset) {
+    *(Mix_Chunk**)user = (Mix_Chunk*)asset;
+}
+
+static void decode_sfx(void* user) {
+    const SfxLoad* load = (const SfxLoad*)user;
+    asset_loader_deliver(load_sfx(load->path), sfx_loaded, load->slot);
+}
+
 
 // --- Public API Implementation ---
 
@@ -41,73 +94,73 @@ void sound_init(void) {
     // You just need to provide the correct paths to your files.
 
     // Music
-    menu_music = load_music("assets/sounds/assets_sounds_fire.mp3"); // Example path
-    music_map1 = load_music("assets/sounds/assets_sounds_ambient.mp3"); // Example path
-    music_map2 = load_music("assets/sounds/assets_sounds_ambient.mp3"); // Example path
-    music_map3 = load_music("assets/sounds/assets_sounds_ambient.mp3"); // Example path
-
-    // Sound Effects
-    sfx_attack = load_sfx("assets/sounds/attack.wav");     // Example path
-    sfx_jump = load_sfx("assets/sounds/jmp.wav");         // Example path
-    sfx_hurt = load_sfx("assets/sounds/assets_sounds_lighthurt.wav");         // Example path
-    sfx_death = load_sfx("assets/sounds/assets_sounds_death.wav");       // Example path
-    sfx_struck = load_sfx("assets/sounds/assets_sounds_sword4.wav");
+    for (int i = 0; i < MUSIC_COUNT; i++) {
+        *music_loads[i].slot = load_music(music_loads[i].path);
+    }
+
+    // Sound Effects (decoded in the background when the asset loader runs)
+    for (int i = 0; i < SFX_COUNT; i++) {
+        if (asset_loader_running()) {
+            asset_loader_queue(decode_sfx, (void*)&sfx_loads[i]);
+        } else {
+            *sfx_loads[i].slot = load_sfx(sfx_loads[i].path);
+        }
+    }
 }
 
 void sound_play_music(const char* map_name) {
-    Mix_Music* music_to_play = NULL;
-
-    if (strcmp(map_name, "menu") == 0) music_to_play = menu_music;
-    if (strcmp(map_name, "map1") == 0) music_to_play = music_map1;
-    if (strcmp(map_name, "map2") == 0) music_to_play = music_map2;
-    if (strcmp(map_name, "map3") == 0) music_to_play = music_map3;
-
-    if (music_to_play) {
-        Mix_FadeInMusic(music_to_play, -1, 2000); // Play music with a 2-second fade-in
+    for (int i = 0; i < MUSIC_COUNT; i++) {
+        if (strcmp(map_name, music_loads[i].name) == 0 && *music_loads[i].slot) {
+            music_playing = &music_loads[i];
+            Mix_FadeInMusic(*music_loads[i].slot, -1, 2000); // Play music with a 2-second fade-in
+        }
     }
 }
 
-void sound_play_effects(Player *p1, Player2 *p2, Enemy *enemy) {
-    // We use static bools to track the state from the previous frame.
-    // This ensures a sound effect only plays ONCE when the state changes.
-    static PlayerState last_p1_state = PLAYER_IDLE;
-    static Player2State last_p2_state = PLAYER2_IDLE;
-    static EnemyState last_enemy_state = ENEMY_IDLE;
-
-    // --- Player 1 Sound Effects ---
-    if (p1) {
-        if ((p1->state == PLAYER_ATTACKING && last_p1_state != PLAYER_ATTACKING) || (p1->state == PLAYER_DOWN_ATTACK && last_p1_state != PLAYER_DOWN_ATTACK)) Mix_PlayChannel(-1, sfx_attack, 0);
-        if (p1->state == PLAYER_JUMPING && last_p1_state != PLAYER_JUMPING) Mix_PlayChannel(-1, sfx_jump, 0);
-        if ((p1->state == PLAYER_HURT && last_p1_state != PLAYER_HURT) || (p1->state == PLAYER_BLOCK_HURT && last_p1_state != PLAYER_BLOCK_HURT)) {
-            Mix_PlayChannel(-1, sfx_hurt, 0);
-            Mix_PlayChannel(-1, sfx_struck, 0);
-        }
-        if (p1->state == PLAYER_DEATH && last_p1_state != PLAYER_DEATH) Mix_PlayChannel(-1, sfx_death, 0);
-        last_p1_state = p1->state;
+bool sound_reload(const char* path) {
+    bool found = false;
+
+    // Freeing a chunk halts the channels playing it; the next trigger uses the new one
+    for (int i = 0; i < SFX_COUNT; i++) {
+        if (strcmp(path, sfx_loads[i].path) != 0) continue;
+        found = true;
+        Mix_Chunk* chunk = load_sfx(path);
+        if (!chunk) continue;
+        Mix_FreeChunk(*sfx_loads[i].slot);
+        *sfx_loads[i].slot = chunk;
     }
 
-    // --- Player 2 Sound Effects ---
-    if (p2) {
-        if ((p2->state == PLAYER2_ATTACKING && last_p2_state != PLAYER2_ATTACKING) || (p2->state == PLAYER2_DOWN_ATTACK && last_p2_state != PLAYER2_DOWN_ATTACK)) Mix_PlayChannel(-1, sfx_attack, 0);
-        if (p2->state == PLAYER2_JUMPING && last_p2_state != PLAYER2_JUMPING) Mix_PlayChannel(-1, sfx_jump, 0);
-        if ((p2->state == PLAYER2_HURT && last_p2_state != PLAYER2_HURT) || (p2->state == PLAYER2_BLOCK_HURT && last_p2_state != PLAYER2_BLOCK_HURT)) {
-            Mix_PlayChannel(-1, sfx_hurt, 0);
-            Mix_PlayChannel(-1, sfx_struck, 0);
-        }
-        if (p2->state == PLAYER2_DEATH && last_p2_state != PLAYER2_DEATH) Mix_PlayChannel(-1, sfx_death, 0);
-        last_p2_state = p2->state;
+    // Music the same way; the track that was playing starts again
+    const MusicLoad* restart = NULL;
+    for (int i = 0; i < MUSIC_COUNT; i++) {
+        if (strcmp(path, music_loads[i].path) != 0) continue;
+        found = true;
+        Mix_Music* music = load_music(path);
+        if (!music) continue;
+        if (music_playing == &music_loads[i] && Mix_PlayingMusic()) restart = music_playing;
+        Mix_FreeMusic(*music_loads[i].slot);
+        *music_loads[i].slot = music;
     }
+    if (restart) Mix_PlayMusic(*restart->slot, -1);
+    return found;
+}
 
-    // --- Enemy Sound Effects ---
-    if (enemy) {
-        if (enemy->state == ENEMY_ATTACKING && last_enemy_state != ENEMY_ATTACKING) Mix_PlayChannel(-1, sfx_attack, 0);
-        if (enemy->state == ENEMY_JUMPING && last_enemy_state != ENEMY_JUMPING) Mix_PlayChannel(-1, sfx_jump, 0);
-        if ((enemy->state == ENEMY_HURT && last_enemy_state != ENEMY_HURT) || (enemy->state == ENEMY_BLOCK_HURT && last_enemy_state != ENEMY_BLOCK_HURT)){
+void sound_play_effects(const FighterStore *fighters) {
+    // We keep each fighter's state from the previous frame.
+    // This ensures a sound effect only plays ONCE when the state changes.
+    static Uint8 last_state[MAX_FIGHTERS] = {FIGHTER_IDLE};
+
+    for (int id = 0; id < fighters->count; ++id) {
+        Uint8 state = fighters->state[id];
+        Uint8 last = last_state[id];
+        if ((state == FIGHTER_ATTACKING && last != FIGHTER_ATTACKING) || (state == FIGHTER_DOWN_ATTACK && last != FIGHTER_DOWN_ATTACK)) Mix_PlayChannel(-1, sfx_attack, 0);
+        if (state == FIGHTER_JUMPING && last != FIGHTER_JUMPING) Mix_PlayChannel(-1, sfx_jump, 0);
+        if ((state == FIGHTER_HURT && last != FIGHTER_HURT) || (state == FIGHTER_BLOCK_HURT && last != FIGHTER_BLOCK_HURT)) {
             Mix_PlayChannel(-1, sfx_hurt, 0);
             Mix_PlayChannel(-1, sfx_struck, 0);
         }
-        if (enemy->state == ENEMY_DEATH && last_enemy_state != ENEMY_DEATH) Mix_PlayChannel(-1, sfx_death, 0);
-        last_enemy_state = enemy->state;
+        if (state == FIGHTER_DEATH && last != FIGHTER_DEATH) Mix_PlayChannel(-1, sfx_death, 0);
+        last_state[id] = state;
     }
 }
 
@@ -118,13 +171,13 @@ void sound_stop_all(void) {
 
 void sound_quit(void) {
     // Free all loaded sound resources
-    Mix_FreeMusic(menu_music);
-    Mix_FreeMusic(music_map1);
-    Mix_FreeMusic(music_map2);
-    Mix_FreeMusic(music_map3);
+    for (int i = 0; i < MUSIC_COUNT; i++) {
+        Mix_FreeMusic(*music_loads[i].slot);
+        *music_loads[i].slot = NULL;
+    }
     
-    Mix_FreeChunk(sfx_attack);
-    Mix_FreeChunk(sfx_jump);
-    Mix_FreeChunk(sfx_hurt);
-    Mix_FreeChunk(sfx_death);
+    for (int i = 0; i < SFX_COUNT; i++) {
+        Mix_FreeChunk(*sfx_loads[i].slot);
+        *sfx_loads[i].slot = NULL;
+    }
 }
\ No newline at end of file
@@ -0,0 +1,158 @@
+#include "sprite_batch.h"
+#include <stdbool.h>
+
+static SDL_Vertex vertices[SPRITE_BATCH_MAX_QUADS * 4];
+static int indices[SPRITE_BATCH_MAX_QUADS * 6];
+static bool indices_ready = false;
+
+/* The pending run: quads that all use `texture` on `renderer` */
+static SDL_Renderer *batch_renderer;
+static SDL_Texture *batch_texture;
+static int batch_quads;
+
+/* Size of the last texture a sprite was cut from, for normalising `src` */
+static SDL_Texture *sized_texture;
+static float sized_w = 1.0f, sized_h = 1.0f;
+
+static int frame_quads, frame_draws;
+static int last_quads, last_draws;
+
+void sprite_batch_flush(void)
+{
+    if (batch_quads == 0)
+        return;
+
+    if (!indices_ready)
+    {
+        for (int i = 0; i < SPRITE_BATCH_MAX_QUADS; ++i)
+        {
+            int *idx = &indices[i * 6];
+            idx[0] = i * 4;
+            idx[1] = i * 4 + 1;
+            idx[2] = i * 4 + 2;
+            idx[3] = i * 4;
+            idx[4] = i * 4 + 2;
+            idx[5] = i * 4 + 3;
+        }
+        indices_ready = true;
+    }
+
+    if (batch_texture)
+    {
+        SDL_RenderGeometry(batch_renderer, batch_texture, vertices, batch_quads * 4, indices, batch_quads * 6);
+    }
+    else
+    {
+        /* Untextured geometry blends with the draw blend mode */
+        SDL_BlendMode mode;
+        SDL_GetRenderDrawBlendMode(batch_renderer, &mode);
+        SDL_SetRenderDrawBlendMode(batch_renderer, SDL_BLENDMODE_BLEND);
+        SDL_RenderGeometry(batch_renderer, NULL, vertices, batch_quads * 4, indices, batch_quads * 6);
+        SDL_SetRenderDrawBlendMode(batch_renderer, mode);
+    }
+    frame_quads += batch_quads;
+    frame_draws++;
+    batch_quads = 0;
+}
+
+/* Room for one more quad in a run on `texture` */
+static SDL_Vertex *next_quad(SDL_Renderer *renderer, SDL_Texture *texture)
+{
+    if (batch_quads > 0 && (renderer != batch_renderer || texture != batch_texture))
+        sprite_batch_flush();
+    if (batch_quads == SPRITE_BATCH_MAX_QUADS)
+        sprite_batch_flush();
+    batch_renderer = renderer;
+    batch_texture = texture;
+    return &vertices[batch_quads++ * 4];
+}
+
+static void put_quad(SDL_Vertex *v, const SDL_FRect *dst, SDL_FPoint uv0, SDL_FPoint uv1, SDL_Color color)
+{
+    float x0 = dst->x, y0 = dst->y, x1 = dst->x + dst->w, y1 = dst->y + dst->h;
+    v[0] = (SDL_Vertex){{x0, y0}, color, {uv0.x, uv0.y}};
+    v[1] = (SDL_Vertex){{x1, y0}, color, {uv1.x, uv0.y}};
+    v[2] = (SDL_Vertex){{x1, y1}, color, {uv1.x, uv1.y}};
+    v[3] = (SDL_Vertex){{x0, y1}, color, {uv0.x, uv1.y}};
+}
+
+void sprite_batch_sprite(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect *src, const SDL_FRect *dst,
+                         SDL_RendererFlip flip, SDL_Color tint)
+{
+    if (!renderer || !texture)
+        return;
+
+    SDL_FPoint uv0 = {0.0f, 0.0f}, uv1 = {1.0f, 1.0f};
+    if (src)
+    {
+        if (texture != sized_texture)
+        {
+            int w = 1, h = 1;
+            SDL_QueryTexture(texture, NULL, NULL, &w, &h);
+            sized_texture = texture;
+            sized_w = (float)(w > 0 ? w : 1);
+            sized_h = (float)(h > 0 ? h : 1);
+        }
+        uv0 = (SDL_FPoint){(float)src->x / sized_w, (float)src->y / sized_h};
+        uv1 = (SDL_FPoint){(float)(src->x + src->w) / sized_w, (float)(src->y + src->h) / sized_h};
+    }
+    if (flip & SDL_FLIP_HORIZONTAL)
+    {
+        float u = uv0.x;
+        uv0.x = uv1.x;
+        uv1.x = u;
+    }
+    if (flip & SDL_FLIP_VERTICAL)
+    {
+        float v = uv0.y;
+        uv0.y = uv1.y;
+        uv1.y = v;
+    }
+    put_quad(next_quad(renderer, texture), dst, uv0, uv1, tint);
+}
+
+void sprite_batch_quad(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_FRect *dst, SDL_FPoint uv0,
+                       SDL_FPoint uv1, SDL_Color tint)
+{
+    if (!renderer || !texture)
+        return;
+    put_quad(next_quad(renderer, texture), dst, uv0, uv1, tint);
+}
+
+void sprite_batch_fill(SDL_Renderer *renderer, const SDL_FRect *rect, SDL_Color color)
+{
+    if (!renderer)
+        return;
+    SDL_FPoint none = {0.0f, 0.0f};
+    put_quad(next_quad(renderer, NULL), rect, none, none, color);
+}
+
+void sprite_batch_outline(SDL_Renderer *renderer, const SDL_FRect *rect, SDL_Color color)
+{
+    SDL_FRect top = {rect->x, rect->y, rect->w, 1.0f};
+    SDL_FRect bottom = {rect->x, rect->y + rect->h - 1.0f, rect->w, 1.0f};
+    SDL_FRect left = {rect->x, rect->y + 1.0f, 1.0f, rect->h - 2.0f};
+    SDL_FRect right = {rect->x + rect->w - 1.0f, rect->y + 1.0f, 1.0f, rect->h - 2.0f};
+    sprite_batch_fill(renderer, &top, color);
+    sprite_batch_fill(renderer, &bottom, color);
+    sprite_batch_fill(renderer, &left, color);
+    sprite_batch_fill(renderer, &right, color);
+}
+
+void sprite_batch_end_frame(void)
+{
+    sprite_batch_flush();
+    last_quads = frame_quads;
+    last_draws = frame_draws;
+    frame_quads = frame_draws = 0;
+    /* Textures may be destroyed between frames; don't trust the cached size */
+    sized_texture = NULL;
+}
+
+void sprite_batch_stats(int *quads, int *draw_calls)
+{
+    if (quads)
+        *quads = last_quads;
+    if (draw_calls)
+        *draw_calls = last_draws;
+}
@@ -0,0 +1,100 @@
+#include "sprite_sheet.h"
+#include "asset_pack.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+/* Read just the BITMAPINFOHEADER size fields instead of decoding the
+ * (multi-megabyte) pixel data. */
+static bool read_bmp_size(const char *path, int *w, int *h)
+{
+    SDL_RWops *rw = SDL_RWFromFile(path, "rb");
+    if (!rw)
+    {
+        fprintf(stderr, "Failed to open BMP %s: %s\n", path, SDL_GetError());
+        return false;
+    }
+
+    bool ok = false;
+    if (SDL_ReadLE16(rw) == 0x4D42 && SDL_RWseek(rw, 18, RW_SEEK_SET) == 18)
+    {
+        Sint32 width = (Sint32)SDL_ReadLE32(rw);
+        Sint32 height = (Sint32)SDL_ReadLE32(rw);
+        *w = width;
+        *h = height < 0 ? -height : height; /* negative = top-down rows */
+        ok = width > 0;
+    }
+    SDL_RWclose(rw);
+
+    if (!ok)
+        fprintf(stderr, "Not a valid BMP: %s\n", path);
+    return ok;
+}
+
+SpriteSheet *create_sprite_sheet(SDL_Renderer *renderer, const char *path)
+{
+    SpriteSheet *sheet = (SpriteSheet *)calloc(1, sizeof(SpriteSheet));
+    if (!sheet)
+        return NULL;
+
+    const AssetPackEntry *packed = asset_pack_find(path);
+    if (!renderer)
+    {
+        if (packed && packed->kind == PACK_ENTRY_PIXELS)
+        {
+            sheet->w = (int)packed->w;
+            sheet->h = (int)packed->h;
+        }
+        else if (!read_bmp_size(path, &sheet->w, &sheet->h))
+        {
+            free(sheet);
+            return NULL;
+        }
+        sheet->region = (SDL_Rect){0, 0, sheet->w, sheet->h};
+        return sheet;
+    }
+
+    /* Packed pixels already carry the colour key as alpha */
+    SDL_Surface *surface = asset_pack_surface(path);
+    if (!surface)
+    {
+        surface = SDL_LoadBMP(path);
+        if (!surface)
+        {
+            fprintf(stderr, "Failed to load BMP %s: %s\n", path, SDL_GetError());
+            free(sheet);
+            return NULL;
+        }
+        SDL_SetColorKey(surface, SDL_TRUE, SDL_MapRGB(surface->format, 255, 0, 255));
+    }
+    sheet->texture = SDL_CreateTextureFromSurface(renderer, surface);
+    sheet->w = surface->w;
+    sheet->h = surface->h;
+    sheet->region = (SDL_Rect){0, 0, sheet->w, sheet->h};
+    SDL_FreeSurface(surface);
+    if (sheet->texture && packed)
+        SDL_SetTextureBlendMode(sheet->texture, SDL_BLENDMODE_BLEND);
+    if (!sheet->texture)
+    {
+        fprintf(stderr, "Failed to create texture from %s: %s\n", path, SDL_GetError());
+        free(sheet);
+        return NULL;
+    }
+    return sheet;
+}
+
+void destroy_sprite_sheet(SpriteSheet *sheet)
+{
+    if (!sheet)
+        return;
+    if (sheet->texture && !sheet->shared_texture)
+        SDL_DestroyTexture(sheet->texture);
+    free(sheet);
+}
+
+SDL_Rect sprite_sheet_frame(const SpriteSheet *sheet, int frame, int frame_count)
+{
+    int frame_w = frame_count > 0 ? sheet->w / frame_count : sheet->w;
+    SDL_Rect r = {sheet->region.x + frame * frame_w, sheet->region.y, frame_w, sheet->h};
+    return r;
+}
@@ -0,0 +1,339 @@
+#include "texture_atlas.h"
+#include "asset_cache.h"
+#include "asset_loader.h"
+#include "asset_pack.h"
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_ATLAS_SHEETS 64
+#define MAX_ATLAS_PAGES 8
+#define FALLBACK_MAX_TEXTURE_SIZE 4096
+#define ATLAS_PADDING 2 /* keeps linear filtering from bleeding across sheets */
+
+typedef struct
+{
+    const char *path;
+    SDL_Surface *surface;
+    int w, h;
+    int page;
+    int x, y;
+} PackItem;
+
+/* One packing run. Loading and composing the page surfaces touch no
+ * renderer state, so with the asset loader running they happen on its
+ * worker and only the page uploads land on the main thread. */
+typedef struct
+{
+    char names[MAX_ATLAS_SHEETS][256];
+    PackItem items[MAX_ATLAS_SHEETS];
+    int item_count;
+    SDL_Surface *page_surfaces[MAX_ATLAS_PAGES];
+    int page_count;
+    int pages_done; /* async: pages handed back by the loader so far */
+    int max_w, max_h;
+} AtlasBuild;
+
+static SDL_Texture *pages[MAX_ATLAS_PAGES];
+static int page_count = 0;
+
+static int compare_items(const void *a, const void *b)
+{
+    const PackItem *ia = (const PackItem *)a;
+    const PackItem *ib = (const PackItem *)b;
+    if (ia->h != ib->h)
+        return ib->h - ia->h;
+    return ib->w - ia->w;
+}
+
+/* First-fit shelf packer: tallest sheets first, each placed on the first
+ * shelf of its page with room left, opening a new shelf (or page) only when
+ * none fits. Fighter sheets are all one 258 px row tall, so shelves waste
+ * almost nothing. Returns the number of pages used. */
+#define MAX_SHELVES 64
+
+typedef struct
+{
+    int page, y, h, x;
+} Shelf;
+
+static int pack_shelves(PackItem *items, int count, int max_w, int max_h, int *page_w, int *page_h)
+{
+    Shelf shelves[MAX_SHELVES];
+    int shelf_count = 0;
+    int pages_used = 0;
+
+    for (int i = 0; i < count; ++i)
+    {
+        int w = items[i].w, h = items[i].h;
+        items[i].page = -1;
+        if (w > max_w || h > max_h)
+            continue; /* too big for any page */
+
+        Shelf *shelf = NULL;
+        for (int s = 0; s < shelf_count && !shelf; ++s)
+            if (shelves[s].h >= h && shelves[s].x + w <= max_w)
+                shelf = &shelves[s];
+
+        if (!shelf && shelf_count < MAX_SHELVES)
+        {
+            int page = pages_used ? pages_used - 1 : 0;
+            int y = pages_used ? page_h[page] + ATLAS_PADDING : 0;
+            if (y + h > max_h)
+            {
+                page++;
+                y = 0;
+            }
+            if (page < MAX_ATLAS_PAGES)
+            {
+                shelf = &shelves[shelf_count++];
+                *shelf = (Shelf){page, y, h, 0};
+                if (page + 1 > pages_used)
+                    pages_used = page + 1;
+                page_h[page] = y + h;
+            }
+        }
+        if (!shelf)
+            continue;
+
+        items[i].page = shelf->page;
+        items[i].x = shelf->x;
+        items[i].y = shelf->y;
+        shelf->x += w + ATLAS_PADDING;
+        if (shelf->x - ATLAS_PADDING > page_w[shelf->page])
+            page_w[shelf->page] = shelf->x - ATLAS_PADDING;
+    }
+    return pages_used;
+}
+
+static void load_items(AtlasBuild *build)
+{
+    int n = 0;
+    for (int i = 0; i < build->item_count; ++i)
+    {
+        const char *path = build->names[i];
+        SDL_Surface *s = asset_pack_surface(path);
+        if (s)
+        {
+            /* Key is already alpha: a straight copy onto the page */
+            SDL_SetSurfaceBlendMode(s, SDL_BLENDMODE_NONE);
+        }
+        else
+        {
+            s = SDL_LoadBMP(path);
+            if (!s)
+            {
+                fprintf(stderr, "Atlas: failed to load BMP %s: %s\n", path, SDL_GetError());
+                continue;
+            }
+            SDL_SetColorKey(s, SDL_TRUE, SDL_MapRGB(s->format, 255, 0, 255));
+        }
+        PackItem *item = &build->items[n++];
+        item->path = path;
+        item->surface = s;
+        item->w = s->w;
+        item->h = s->h;
+    }
+    build->item_count = n;
+}
+
+/* Blit through the colour key onto transparent RGBA pages, so the key
+ * becomes real alpha and the pages can be drawn blended */
+static void compose_pages(AtlasBuild *build)
+{
+    PackItem *items = build->items;
+    int n = build->item_count;
+    qsort(items, n, sizeof(PackItem), compare_items);
+    int page_w[MAX_ATLAS_PAGES] = {0}, page_h[MAX_ATLAS_PAGES] = {0};
+    int used = pack_shelves(items, n, build->max_w, build->max_h, page_w, page_h);
+
+    for (int p = 0; p < used; ++p)
+    {
+        SDL_Surface *page = SDL_CreateRGBSurfaceWithFormat(0, page_w[p], page_h[p], 32, SDL_PIXELFORMAT_RGBA32);
+        if (!page)
+        {
+            fprintf(stderr, "Atlas: page %d (%dx%d) allocation failed: %s\n", p, page_w[p], page_h[p], SDL_GetError());
+            for (int i = 0; i < n; ++i)
+                if (items[i].page == p)
+                    items[i].page = -1;
+            continue;
+        }
+        SDL_FillRect(page, NULL, SDL_MapRGBA(page->format, 0, 0, 0, 0));
+        for (int i = 0; i < n; ++i)
+        {
+            if (items[i].page != p)
+                continue;
+            SDL_Rect dst = {items[i].x, items[i].y, items[i].w, items[i].h};
+            SDL_BlitSurface(items[i].surface, NULL, page, &dst);
+        }
+        build->page_surfaces[p] = page;
+    }
+    build->page_count = used;
+
+    for (int i = 0; i < n; ++i)
+    {
+        SDL_FreeSurface(items[i].surface);
+        items[i].surface = NULL;
+    }
+}
+
+/* Main thread: keep the page texture and register its sheets in the cache */
+static bool adopt_page(AtlasBuild *build, int p, SDL_Texture *texture)
+{
+    if (page_count == MAX_ATLAS_PAGES)
+    {
+        SDL_DestroyTexture(texture);
+        return false;
+    }
+    pages[page_count++] = texture;
+
+    bool ok = true;
+    for (int i = 0; i < build->item_count; ++i)
+    {
+        PackItem *item = &build->items[i];
+        if (item->page != p)
+            continue;
+        SpriteSheet *sheet = (SpriteSheet *)calloc(1, sizeof(SpriteSheet));
+        if (!sheet)
+        {
+            ok = false;
+            continue;
+        }
+        sheet->texture = texture;
+        sheet->w = item->w;
+        sheet->h = item->h;
+        sheet->region = (SDL_Rect){item->x, item->y, item->w, item->h};
+        sheet->shared_texture = true;
+        if (!asset_cache_insert(item->path, sheet))
+            destroy_sprite_sheet(sheet);
+    }
+    return ok;
+}
+
+static void atlas_page_ready(void *user, void *asset)
+{
+    AtlasBuild *build = (AtlasBuild *)user;
+    int p = build->pages_done++;
+    if (asset)
+        adopt_page(build, p, (SDL_Texture *)asset);
+    if (build->pages_done >= build->page_count)
+        free(build);
+}
+
+/* Worker side of an async build */
+static void atlas_decode(void *user)
+{
+    AtlasBuild *build = (AtlasBuild *)user;
+    load_items(build);
+    compose_pages(build);
+
+    /* The loader uploads these in order, so pages come back in order */
+    if (build->page_count == 0)
+        asset_loader_deliver(NULL, atlas_page_ready, build);
+    for (int p = 0; p < build->page_count; ++p)
+    {
+        if (build->page_surfaces[p])
+            asset_loader_deliver_surface(build->page_surfaces[p], atlas_page_ready, build);
+        else
+            asset_loader_deliver(NULL, atlas_page_ready, build);
+        build->page_surfaces[p] = NULL;
+    }
+}
+
+bool texture_atlas_build(SDL_Renderer *renderer, const char *const *paths, int count)
+{
+    if (!renderer)
+        return false;
+
+    AtlasBuild *build = (AtlasBuild *)calloc(1, sizeof(AtlasBuild));
+    if (!build)
+        return false;
+    for (int i = 0; i < count && build->item_count < MAX_ATLAS_SHEETS; ++i)
+    {
+        if (asset_cache_contains(paths[i]))
+            continue;
+        snprintf(build->names[build->item_count], sizeof(build->names[0]), "%s", paths[i]);
+        build->item_count++;
+    }
+
+    SDL_RendererInfo info;
+    build->max_w = build->max_h = FALLBACK_MAX_TEXTURE_SIZE;
+    if (SDL_GetRendererInfo(renderer, &info) == 0 && info.max_texture_width > 0)
+    {
+        build->max_w = info.max_texture_width;
+        build->max_h = info.max_texture_height;
+    }
+
+    if (asset_loader_running())
+    {
+        asset_loader_queue(atlas_decode, build);
+        return true;
+    }
+
+    load_items(build);
+    compose_pages(build);
+    bool ok = true;
+    for (int p = 0; p < build->page_count; ++p)
+    {
+        SDL_Surface *page = build->page_surfaces[p];
+        SDL_Texture *texture = page ? SDL_CreateTextureFromSurface(renderer, page) : NULL;
+        SDL_FreeSurface(page);
+        if (!texture)
+        {
+            fprintf(stderr, "Atlas: page %d upload failed: %s\n", p, SDL_GetError());
+            ok = false;
+            continue;
+        }
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+        ok = adopt_page(build, p, texture) && ok;
+    }
+    free(build);
+    return ok;
+}
+
+static bool has_bmp_extension(const char *name)
+{
+    size_t len = strlen(name);
+    return len > 4 && (strcmp(name + len - 4, ".bmp") == 0 || strcmp(name + len - 4, ".BMP") == 0);
+}
+
+bool texture_atlas_build_dir(SDL_Renderer *renderer, const char *dir,
+                             const char *const *extra, int extra_count)
+{
+    static char names[MAX_ATLAS_SHEETS][256];
+    const char *paths[MAX_ATLAS_SHEETS];
+    int count = 0;
+
+    /* The pack index replaces the directory scan when it is present */
+    DIR *d = NULL;
+    if (asset_pack_is_open())
+        count = asset_pack_list(dir, paths, MAX_ATLAS_SHEETS - extra_count);
+    else if (!(d = opendir(dir)))
+        fprintf(stderr, "Atlas: cannot open %s\n", dir);
+    if (d)
+    {
+        struct dirent *ent;
+        while ((ent = readdir(d)) && count < MAX_ATLAS_SHEETS - extra_count)
+        {
+            if (!has_bmp_extension(ent->d_name))
+                continue;
+            snprintf(names[count], sizeof(names[count]), "%s/%s", dir, ent->d_name);
+            paths[count] = names[count];
+            count++;
+        }
+        closedir(d);
+    }
+
+    for (int i = 0; i < extra_count && count < MAX_ATLAS_SHEETS; ++i)
+        paths[count++] = extra[i];
+
+    return texture_atlas_build(renderer, paths, count);
+}
+
+void texture_atlas_destroy_all(void)
+{
+    for (int i = 0; i < page_count; ++i)
+        SDL_DestroyTexture(pages[i]);
+    page_count = 0;
+}
@@ -0,0 +1,323 @@
+/* Builds the asset pack (make pack): reads a manifest of "<kind> <path>"
+ * lines and writes one indexed file in the layout described in
+ * asset_pack.h, with images converted to RGBA32 and sound effects decoded
+ * to the game's mixer format so nothing is decoded at startup.
+ *
+ *   smack-pack assets/pack.txt assets/smack.pak */
+#define SDL_MAIN_HANDLED
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <SDL2/SDL_mixer.h>
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "asset_pack.h"
+#include "sound.h"
+
+#define MAX_PACK_ITEMS 256
+
+typedef enum
+{
+    ITEM_SPRITE,
+    ITEM_IMAGE,
+    ITEM_SOUND,
+    ITEM_RAW
+} ItemKind;
+
+typedef struct
+{
+    ItemKind kind;
+    char path[ASSET_PACK_NAME_MAX];
+} PackItem;
+
+static PackItem items[MAX_PACK_ITEMS];
+static int item_count = 0;
+
+static void add_item(ItemKind kind, const char *path)
+{
+    if (strlen(path) >= ASSET_PACK_NAME_MAX)
+    {
+        fprintf(stderr, "skipping %s: path longer than %d bytes\n", path, ASSET_PACK_NAME_MAX - 1);
+        return;
+    }
+    for (int i = 0; i < item_count; ++i)
+        if (strcmp(items[i].path, path) == 0)
+            return;
+    if (item_count == MAX_PACK_ITEMS)
+    {
+        fprintf(stderr, "skipping %s: more than %d items\n", path, MAX_PACK_ITEMS);
+        return;
+    }
+    items[item_count].kind = kind;
+    strcpy(items[item_count].path, path);
+    item_count++;
+}
+
+/* A directory entry in the manifest stands for every file directly in it */
+static void add_path(ItemKind kind, const char *path)
+{
+    DIR *d = opendir(path);
+    if (!d)
+    {
+        add_item(kind, path);
+        return;
+    }
+    struct dirent *ent;
+    while ((ent = readdir(d)))
+    {
+        if (ent->d_name[0] == '.')
+            continue;
+        char full[512];
+        snprintf(full, sizeof(full), "%s/%s", path, ent->d_name);
+        add_item(kind, full);
+    }
+    closedir(d);
+}
+
+static bool read_manifest(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    if (!f)
+    {
+        fprintf(stderr, "cannot open manifest %s\n", path);
+        return false;
+    }
+
+    char line[512];
+    int line_no = 0;
+    while (fgets(line, sizeof(line), f))
+    {
+        line_no++;
+        line[strcspn(line, "\r\n")] = '\0';
+        if (line[0] == '#' || line[0] == '\0')
+            continue;
+
+        /* Everything after the first space is the path (paths may contain spaces) */
+        char *space = strchr(line, ' ');
+        if (!space)
+        {
+            fprintf(stderr, "%s:%d: expected \"<kind> <path>\"\n", path, line_no);
+            continue;
+        }
+        *space = '\0';
+        const char *file = space + 1;
+
+        if (strcmp(line, "sprite") == 0)
+            add_path(ITEM_SPRITE, file);
+        else if (strcmp(line, "image") == 0)
+            add_path(ITEM_IMAGE, file);
+        else if (strcmp(line, "sound") == 0)
+            add_path(ITEM_SOUND, file);
+        else if (strcmp(line, "raw") == 0)
+            add_path(ITEM_RAW, file);
+        else
+            fprintf(stderr, "%s:%d: unknown kind \"%s\"\n", path, line_no, line);
+    }
+    fclose(f);
+    return true;
+}
+
+static int compare_items(const void *a, const void *b)
+{
+    return strcmp(((const PackItem *)a)->path, ((const PackItem *)b)->path);
+}
+
+/* RGBA32 copy with tightly packed rows; for sprites the magenta key becomes
+ * alpha during the conversion. */
+static void *load_pixels(const PackItem *item, AssetPackEntry *entry)
+{
+    SDL_Surface *surface = IMG_Load(item->path);
+    if (!surface)
+    {
+        fprintf(stderr, "skipping %s: %s\n", item->path, IMG_GetError());
+        return NULL;
+    }
+    if (item->kind == ITEM_SPRITE)
+        SDL_SetColorKey(surface, SDL_TRUE, SDL_MapRGB(surface->format, 255, 0, 255));
+
+    SDL_Surface *rgba = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGBA32, 0);
+    SDL_FreeSurface(surface);
+    if (!rgba)
+    {
+        fprintf(stderr, "skipping %s: %s\n", item->path, SDL_GetError());
+        return NULL;
+    }
+
+    size_t row = (size_t)rgba->w * 4;
+    Uint8 *pixels = (Uint8 *)malloc(row * rgba->h);
+    if (pixels)
+    {
+        for (int y = 0; y < rgba->h; ++y)
+            memcpy(pixels + row * y, (Uint8 *)rgba->pixels + (size_t)rgba->pitch * y, row);
+        entry->kind = PACK_ENTRY_PIXELS;
+        entry->size = (Uint32)(row * rgba->h);
+        entry->w = (Uint32)rgba->w;
+        entry->h = (Uint32)rgba->h;
+        entry->format = SDL_PIXELFORMAT_RGBA32;
+    }
+    SDL_FreeSurface(rgba);
+    return pixels;
+}
+
+static void *load_sound(const PackItem *item, AssetPackEntry *entry)
+{
+    Mix_Chunk *chunk = Mix_LoadWAV(item->path);
+    if (!chunk)
+    {
+        fprintf(stderr, "skipping %s: %s\n", item->path, Mix_GetError());
+        return NULL;
+    }
+
+    int freq, channels;
+    Uint16 format;
+    Mix_QuerySpec(&freq, &format, &channels);
+    void *pcm = malloc(chunk->alen);
+    if (pcm)
+    {
+        memcpy(pcm, chunk->abuf, chunk->alen);
+        entry->kind = PACK_ENTRY_PCM;
+        entry->size = chunk->alen;
+        entry->w = (Uint32)freq;
+        entry->h = (Uint32)channels;
+        entry->format = format;
+    }
+    Mix_FreeChunk(chunk);
+    return pcm;
+}
+
+static void *load_raw(const PackItem *item, AssetPackEntry *entry)
+{
+    size_t size = 0;
+    void *data = SDL_LoadFile(item->path, &size);
+    if (!data)
+    {
+        fprintf(stderr, "skipping %s: %s\n", item->path, SDL_GetError());
+        return NULL;
+    }
+    entry->kind = PACK_ENTRY_RAW;
+    entry->size = (Uint32)size;
+    return data;
+}
+
+static void free_blob(const PackItem *item, void *data)
+{
+    if (item->kind == ITEM_RAW)
+        SDL_free(data);
+    else
+        free(data);
+}
+
+static bool write_pack(const char *out_path)
+{
+    FILE *out = fopen(out_path, "wb");
+    if (!out)
+    {
+        fprintf(stderr, "cannot write %s\n", out_path);
+        return false;
+    }
+
+    /* Index first (sized for every item), blobs after it; the index is
+     * written last once offsets are known. Failed items just leave a gap. */
+    AssetPackEntry *entries = (AssetPackEntry *)calloc(item_count, sizeof(AssetPackEntry));
+    Uint32 offset = (Uint32)(sizeof(AssetPackHeader) + sizeof(AssetPackEntry) * item_count);
+    Uint32 count = 0;
+    Uint64 payload = 0;
+    bool ok = entries != NULL;
+
+    for (int i = 0; ok && i < item_count; ++i)
+    {
+        AssetPackEntry *e = &entries[count];
+        void *data = NULL;
+        switch (items[i].kind)
+        {
+        case ITEM_SPRITE:
+        case ITEM_IMAGE:
+            data = load_pixels(&items[i], e);
+            break;
+        case ITEM_SOUND:
+            data = load_sound(&items[i], e);
+            break;
+        case ITEM_RAW:
+            data = load_raw(&items[i], e);
+            break;
+        }
+        if (!data)
+            continue;
+
+        offset = (offset + ASSET_PACK_ALIGN - 1) & ~(Uint32)(ASSET_PACK_ALIGN - 1);
+        if ((Uint64)offset + e->size > 0xFFFFFFFFu)
+        {
+            fprintf(stderr, "pack would exceed 4 GiB at %s\n", items[i].path);
+            ok = false;
+        }
+        else if (fseek(out, (long)offset, SEEK_SET) != 0 || fwrite(data, 1, e->size, out) != e->size)
+        {
+            fprintf(stderr, "write failed at %s\n", items[i].path);
+            ok = false;
+        }
+        free_blob(&items[i], data);
+
+        strcpy(e->path, items[i].path);
+        e->offset = offset;
+        offset += e->size;
+        payload += e->size;
+        count++;
+    }
+
+    AssetPackHeader header = {ASSET_PACK_MAGIC, ASSET_PACK_VERSION, count, 0};
+    if (ok && (fseek(out, 0, SEEK_SET) != 0 ||
+               fwrite(&header, sizeof(header), 1, out) != 1 ||
+               fwrite(entries, sizeof(AssetPackEntry), count, out) != count))
+    {
+        fprintf(stderr, "failed to write the index of %s\n", out_path);
+        ok = false;
+    }
+    if (fclose(out) != 0)
+        ok = false;
+    free(entries);
+
+    if (!ok)
+    {
+        remove(out_path); /* never leave a half-written pack for the game to map */
+        return false;
+    }
+    printf("%s: %u of %d assets, %.1f MiB\n", out_path, count, item_count, payload / (1024.0 * 1024.0));
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc != 3)
+    {
+        fprintf(stderr, "usage: %s <manifest> <output.pak>\n", argv[0]);
+        return 1;
+    }
+    if (SDL_BYTEORDER != SDL_LIL_ENDIAN)
+    {
+        fprintf(stderr, "the pack format is little-endian only\n");
+        return 1;
+    }
+
+    /* Decoding needs an open mixer but no sound card */
+    SDL_setenv("SDL_AUDIODRIVER", "dummy", 1);
+    if (SDL_Init(SDL_INIT_AUDIO) != 0 ||
+        Mix_OpenAudio(SOUND_FREQUENCY, SOUND_FORMAT, SOUND_CHANNELS, SOUND_CHUNK_SIZE) < 0)
+    {
+        fprintf(stderr, "audio init failed: %s\n", SDL_GetError());
+        return 1;
+    }
+    IMG_Init(IMG_INIT_PNG);
+
+    bool ok = read_manifest(argv[1]);
+    if (ok)
+    {
+        qsort(items, item_count, sizeof(PackItem), compare_items);
+        ok = write_pack(argv[2]);
+    }
+
+    IMG_Quit();
+    Mix_CloseAudio();
+    SDL_Quit();
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,462 @@
+/* AI balancing runs (make balance). Plays bot-vs-AI matches on every core
+ * and reports, for each enemy AI tuning tried, how often each side wins,
+ * how long matches last, the damage each move deals per match and what a
+ * simulation tick costs:
+ *
+ *   smack-balance --matches 20000 --sweep ai_attack_range=150:250:25 \
+ *                 --sweep ai_reposition_trigger=400:700:150
+ *
+ * plays 20000 matches for each of the 5 x 3 tunings (any ai_* key from
+ * fighters.txt can be swept; the rest stay as the enemy defines them).
+ * Match i uses seed --seed + i under every tuning, so tunings are compared
+ * on the same games, and every total except the timings is the same for
+ * any thread count. Workers claim matches in chunks from one atomic
+ * counter and keep their own totals, merged at the end. */
+#define SDL_MAIN_HANDLED
+#include <SDL2/SDL.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "headless.h"
+#include "asset_cache.h"
+#include "asset_pack.h"
+
+#define BALANCE_DEFAULT_MATCHES 1000
+#define BALANCE_DEFAULT_TIME_LIMIT_MS (99 * 1000)
+#define BALANCE_MAX_SWEEPS 4
+#define BALANCE_MAX_TUNINGS 1024
+#define BALANCE_MAX_THREADS 256
+#define BALANCE_CHUNK 64 /* matches a worker claims at a time */
+#define BALANCE_POLL_MS 20
+#define BALANCE_PROGRESS_MS 1000
+
+typedef struct
+{
+    char key[32];
+    double from, step;
+    int count;
+} Sweep;
+
+typedef struct
+{
+    Uint64 matches;
+    Uint64 wins[3]; /* draws, player 1, player 2 / the AI */
+    Uint64 ticks;
+    Uint64 damage[2][ANIM_COUNT];
+    Uint64 sim_ns;        /* wall time inside matches */
+    double worst_tick_ns; /* the slowest match, per tick */
+} TuningStats;
+
+static struct
+{
+    bool multiplayer;
+    Uint32 seed;
+    Uint32 time_limit_ms;
+    Uint64 matches; /* per tuning */
+    int tuning_count;
+    AiTuning tunings[BALANCE_MAX_TUNINGS];
+    Uint64 total; /* matches over all tunings */
+    int chunk_count;
+    SDL_atomic_t next_chunk;
+    SDL_atomic_t done_chunks;
+    SDL_atomic_t failed;
+} job;
+
+typedef struct
+{
+    SDL_Thread *thread;
+    TuningStats *stats; /* one per tuning */
+} Worker;
+
+static int worker_run(void *data)
+{
+    Worker *w = (Worker *)data;
+    SimState *sim = (SimState *)malloc(sizeof(SimState));
+    if (!sim)
+    {
+        SDL_AtomicSet(&job.failed, 1);
+        return 1;
+    }
+    Uint64 freq = SDL_GetPerformanceFrequency();
+
+    for (;;)
+    {
+        int chunk = SDL_AtomicAdd(&job.next_chunk, 1);
+        if (chunk >= job.chunk_count || SDL_AtomicGet(&job.failed))
+            break;
+        Uint64 first = (Uint64)chunk * BALANCE_CHUNK;
+        Uint64 last = first + BALANCE_CHUNK < job.total ? first + BALANCE_CHUNK : job.total;
+        for (Uint64 i = first; i < last; ++i)
+        {
+            int t = (int)(i / job.matches);
+            Uint32 seed = job.seed + (Uint32)(i % job.matches);
+            HeadlessMatch match;
+            Uint64 start = SDL_GetPerformanceCounter();
+            if (!headless_play_match(sim, job.multiplayer, seed, job.time_limit_ms, &job.tunings[t], &match))
+            {
+                fprintf(stderr, "Balance: match with seed %u failed to start.\n", (unsigned)seed);
+                SDL_AtomicSet(&job.failed, 1);
+                break;
+            }
+            double ns = (double)(SDL_GetPerformanceCounter() - start) * 1e9 / (double)freq;
+
+            TuningStats *s = &w->stats[t];
+            s->matches++;
+            s->wins[match.winner]++;
+            s->ticks += match.ticks;
+            for (int side = 0; side < 2; ++side)
+                for (int a = 0; a < ANIM_COUNT; ++a)
+                    s->damage[side][a] += match.damage[side][a];
+            s->sim_ns += (Uint64)ns;
+            if (match.ticks > 0 && ns / match.ticks > s->worst_tick_ns)
+                s->worst_tick_ns = ns / match.ticks;
+        }
+        SDL_AtomicAdd(&job.done_chunks, 1);
+    }
+    free(sim);
+    return 0;
+}
+
+/* "key=from:to:step" or "key=value" */
+static bool parse_sweep(const char *arg, Sweep *sweep)
+{
+    const char *eq = strchr(arg, '=');
+    if (!eq || eq == arg || (size_t)(eq - arg) >= sizeof(sweep->key))
+        return false;
+    memcpy(sweep->key, arg, (size_t)(eq - arg));
+    sweep->key[eq - arg] = '\0';
+
+    double from, to, step;
+    char extra;
+    int fields = sscanf(eq + 1, "%lf:%lf:%lf%c", &from, &to, &step, &extra);
+    if (fields == 1)
+    {
+        to = from;
+        step = 1.0;
+    }
+    else if (fields != 3 || step <= 0.0 || to < from)
+    {
+        return false;
+    }
+    AiTuning scratch = fighter_ai_defaults;
+    if (!fighter_ai_set(&scratch, sweep->key, from) || !fighter_ai_set(&scratch, sweep->key, to))
+        return false;
+    sweep->from = from;
+    sweep->step = step;
+    sweep->count = (int)((to - from) / step + 1e-9) + 1;
+    return true;
+}
+
+/* Every combination of the sweeps' values on top of the enemy's own tuning */
+static bool build_tunings(const Sweep *sweeps, int sweep_count)
+{
+    int count = 1;
+    for (int s = 0; s < sweep_count; ++s)
+    {
+        if (sweeps[s].count > BALANCE_MAX_TUNINGS / count)
+        {
+            fprintf(stderr, "Balance: more than %d tunings.\n", BALANCE_MAX_TUNINGS);
+            return false;
+        }
+        count *= sweeps[s].count;
+    }
+
+    for (int t = 0; t < count; ++t)
+    {
+        AiTuning *ai = &job.tunings[t];
+        *ai = fighter_archetypes[ARCHETYPE_ENEMY].ai;
+        int rest = t;
+        for (int s = sweep_count - 1; s >= 0; --s)
+        {
+            fighter_ai_set(ai, sweeps[s].key, sweeps[s].from + sweeps[s].step * (rest % sweeps[s].count));
+            rest /= sweeps[s].count;
+        }
+        if (!fighter_ai_valid(ai))
+        {
+            fprintf(stderr, "Balance: a sweep puts an ai_*_min_ms above its max.\n");
+            return false;
+        }
+    }
+    job.tuning_count = count;
+    return true;
+}
+
+/* "ai_attack_range=175 ai_reposition_trigger=550" for the swept keys only */
+static void tuning_label(const Sweep *sweeps, int sweep_count, int t, char *out, size_t size)
+{
+    size_t len = 0;
+    out[0] = '\0';
+    int rest = t;
+    for (int s = sweep_count - 1; s >= 0; --s)
+    {
+        double value = sweeps[s].from + sweeps[s].step * (rest % sweeps[s].count);
+        rest /= sweeps[s].count;
+        char part[64];
+        int n = snprintf(part, sizeof(part), "%s=%g%s", sweeps[s].key, value, s < sweep_count - 1 ? " " : "");
+        if (n > 0 && len + (size_t)n < size)
+        {
+            memmove(out + n, out, len + 1); /* built back to front */
+            memcpy(out, part, (size_t)n);
+            len += (size_t)n;
+        }
+    }
+    if (sweep_count == 0)
+        snprintf(out, size, "enemy as defined");
+}
+
+static double per_match(Uint64 total, Uint64 matches)
+{
+    return matches ? (double)total / (double)matches : 0.0;
+}
+
+static void print_results(const TuningStats *stats, const Sweep *sweeps, int sweep_count)
+{
+    const char *p2 = job.multiplayer ? "P2" : "AI";
+    printf("\n%-44s %7s %7s %6s %8s %8s %8s\n", "tuning", "P1 win", job.multiplayer ? "P2 win" : "AI win",
+           "draw", "length", "ns/tick", "worst");
+    for (int t = 0; t < job.tuning_count; ++t)
+    {
+        const TuningStats *s = &stats[t];
+        double n = s->matches ? (double)s->matches : 1.0;
+        char label[256];
+        tuning_label(sweeps, sweep_count, t, label, sizeof(label));
+        printf("%-44s %6.1f%% %6.1f%% %5.1f%% %6.1f s %8.0f %8.0f\n", label,
+               100.0 * s->wins[1] / n, 100.0 * s->wins[2] / n, 100.0 * s->wins[0] / n,
+               per_match(s->ticks, s->matches) * (SIM_STEP_MS / 1000.0),
+               s->ticks ? (double)s->sim_ns / (double)s->ticks : 0.0, s->worst_tick_ns);
+    }
+
+    /* Only the moves that hurt anyone */
+    bool used[2][ANIM_COUNT] = {{false}};
+    for (int t = 0; t < job.tuning_count; ++t)
+        for (int side = 0; side < 2; ++side)
+            for (int a = 0; a < ANIM_COUNT; ++a)
+                used[side][a] |= stats[t].damage[side][a] > 0;
+
+    printf("\nDamage per match by move\n%-44s", "tuning");
+    for (int side = 0; side < 2; ++side)
+        for (int a = 0; a < ANIM_COUNT; ++a)
+            if (used[side][a])
+            {
+                char column[32];
+                snprintf(column, sizeof(column), "%s %s", side == 0 ? "P1" : p2, fighter_anim_name((AnimId)a));
+                printf(" %14s", column);
+            }
+    printf("\n");
+    for (int t = 0; t < job.tuning_count; ++t)
+    {
+        char label[256];
+        tuning_label(sweeps, sweep_count, t, label, sizeof(label));
+        printf("%-44s", label);
+        for (int side = 0; side < 2; ++side)
+            for (int a = 0; a < ANIM_COUNT; ++a)
+                if (used[side][a])
+                    printf(" %14.1f", per_match(stats[t].damage[side][a], stats[t].matches));
+        printf("\n");
+    }
+}
+
+static bool write_json(const char *path, const TuningStats *stats)
+{
+    FILE *f = fopen(path, "w");
+    if (!f)
+    {
+        fprintf(stderr, "Can't write %s\n", path);
+        return false;
+    }
+    /* One tuning per line, with every ai_* setting it played under */
+    fprintf(f, "{\n  \"seed\": %u, \"matches_per_tuning\": %lu, \"multiplayer\": %s,\n  \"tunings\": [\n",
+            (unsigned)job.seed, (unsigned long)job.matches, job.multiplayer ? "true" : "false");
+    for (int t = 0; t < job.tuning_count; ++t)
+    {
+        const TuningStats *s = &stats[t];
+        const AiTuning *ai = &job.tunings[t];
+        fprintf(f,
+                "    {\"ai_attack_range\": %g, \"ai_block_range\": %g, \"ai_reposition_trigger\": %g, "
+                "\"ai_reposition_speed\": %g, \"ai_reposition_min_ms\": %u, \"ai_reposition_max_ms\": %u, "
+                "\"ai_cooldown_min_ms\": %u, \"ai_cooldown_max_ms\": %u, ",
+                ai->attack_range, ai->block_range, ai->reposition_trigger, ai->reposition_speed,
+                (unsigned)ai->reposition_min_ms, (unsigned)ai->reposition_max_ms,
+                (unsigned)ai->cooldown_min_ms, (unsigned)ai->cooldown_max_ms);
+        fprintf(f, "\"matches\": %lu, \"p1_wins\": %lu, \"p2_wins\": %lu, \"draws\": %lu, \"avg_ticks\": %.1f, "
+                   "\"ns_per_tick\": %.1f, \"worst_ns_per_tick\": %.1f",
+                (unsigned long)s->matches, (unsigned long)s->wins[1], (unsigned long)s->wins[2],
+                (unsigned long)s->wins[0], per_match(s->ticks, s->matches),
+                s->ticks ? (double)s->sim_ns / (double)s->ticks : 0.0, s->worst_tick_ns);
+        for (int side = 0; side < 2; ++side)
+        {
+            fprintf(f, ", \"%s_damage\": {", side == 0 ? "p1" : "p2");
+            bool first = true;
+            for (int a = 0; a < ANIM_COUNT; ++a)
+                if (s->damage[side][a])
+                {
+                    fprintf(f, "%s\"%s\": %.2f", first ? "" : ", ", fighter_anim_name((AnimId)a),
+                            per_match(s->damage[side][a], s->matches));
+                    first = false;
+                }
+            fprintf(f, "}");
+        }
+        fprintf(f, "}%s\n", t + 1 < job.tuning_count ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+    fclose(f);
+    return true;
+}
+
+static void print_usage(const char *prog)
+{
+    fprintf(stderr,
+            "usage: %s [--matches N (per tuning)] [--threads T] [--seed S] [--time-limit SECONDS] [--multi]\n"
+            "          [--sweep ai_KEY=FROM:TO:STEP | ai_KEY=VALUE]... [--json FILE]\n",
+            prog);
+}
+
+int main(int argc, char *argv[])
+{
+    long long matches = BALANCE_DEFAULT_MATCHES;
+    int threads = SDL_GetCPUCount();
+    const char *json_path = NULL;
+    Sweep sweeps[BALANCE_MAX_SWEEPS];
+    int sweep_count = 0;
+    job.seed = 1;
+    job.time_limit_ms = BALANCE_DEFAULT_TIME_LIMIT_MS;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        bool has_value = i + 1 < argc;
+        if (strcmp(argv[i], "--matches") == 0 && has_value)
+            matches = atoll(argv[++i]);
+        else if (strcmp(argv[i], "--threads") == 0 && has_value)
+            threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--seed") == 0 && has_value)
+            job.seed = (Uint32)strtoul(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "--time-limit") == 0 && has_value)
+            job.time_limit_ms = (Uint32)atoi(argv[++i]) * 1000;
+        else if (strcmp(argv[i], "--multi") == 0)
+            job.multiplayer = true;
+        else if (strcmp(argv[i], "--json") == 0 && has_value)
+            json_path = argv[++i];
+        else if (strcmp(argv[i], "--sweep") == 0 && has_value)
+        {
+            if (sweep_count == BALANCE_MAX_SWEEPS || !parse_sweep(argv[++i], &sweeps[sweep_count++]))
+            {
+                fprintf(stderr, "Balance: bad sweep '%s' (at most %d, each an ai_* key from fighters.txt).\n",
+                        argv[i], BALANCE_MAX_SWEEPS);
+                return 1;
+            }
+        }
+        else
+        {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+    if (matches < 1 || threads < 1 || threads > BALANCE_MAX_THREADS)
+    {
+        print_usage(argv[0]);
+        return 1;
+    }
+    if (job.multiplayer && sweep_count > 0)
+    {
+        fprintf(stderr, "Balance: there is no AI to tune in multiplayer (--multi is two bots).\n");
+        return 1;
+    }
+
+    asset_pack_open(ASSET_PACK_PATH); /* sheet sizes come from its index */
+    bool ok = fighter_assets_acquire(NULL) && build_tunings(sweeps, sweep_count);
+    job.matches = (Uint64)matches;
+    job.total = job.matches * (Uint64)job.tuning_count;
+    if (ok && (job.total + BALANCE_CHUNK - 1) / BALANCE_CHUNK > (Uint64)INT_MAX)
+    {
+        fprintf(stderr, "Balance: too many matches.\n");
+        ok = false;
+    }
+    job.chunk_count = (int)((job.total + BALANCE_CHUNK - 1) / BALANCE_CHUNK);
+
+    Worker workers[BALANCE_MAX_THREADS];
+    memset(workers, 0, sizeof(workers));
+    int started = 0;
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (int i = 0; ok && i < threads; ++i)
+    {
+        workers[i].stats = (TuningStats *)calloc((size_t)job.tuning_count, sizeof(TuningStats));
+        char name[32];
+        snprintf(name, sizeof(name), "balance-%d", i);
+        if (workers[i].stats)
+            workers[i].thread = SDL_CreateThread(worker_run, name, &workers[i]);
+        if (!workers[i].thread)
+        {
+            fprintf(stderr, "Balance: could not start worker %d: %s\n", i, SDL_GetError());
+            free(workers[i].stats);
+            SDL_AtomicSet(&job.failed, 1);
+            ok = false;
+            break;
+        }
+        started++;
+    }
+    if (ok)
+        printf("%lu %s matches (%d tunings x %lu) on %d threads\n", (unsigned long)job.total,
+               job.multiplayer ? "multiplayer" : "single-player", job.tuning_count, (unsigned long)job.matches,
+               started);
+
+    fflush(stdout);
+
+    /* Progress on stderr, so stdout stays a clean report */
+    Uint32 shown = SDL_GetTicks();
+    while (ok && SDL_AtomicGet(&job.done_chunks) < job.chunk_count && !SDL_AtomicGet(&job.failed))
+    {
+        SDL_Delay(BALANCE_POLL_MS);
+        if (SDL_GetTicks() - shown >= BALANCE_PROGRESS_MS)
+        {
+            fprintf(stderr, "\r%5.1f%%", 100.0 * SDL_AtomicGet(&job.done_chunks) / job.chunk_count);
+            shown = SDL_GetTicks();
+        }
+    }
+    if (ok)
+        fprintf(stderr, "\r       \r");
+    for (int i = 0; i < started; ++i)
+        SDL_WaitThread(workers[i].thread, NULL);
+    double secs = (double)(SDL_GetPerformanceCounter() - start) / (double)SDL_GetPerformanceFrequency();
+    if (SDL_AtomicGet(&job.failed))
+        ok = false;
+
+    /* Merge into the first worker's totals */
+    TuningStats *stats = workers[0].stats;
+    for (int i = 1; ok && i < started; ++i)
+        for (int t = 0; t < job.tuning_count; ++t)
+        {
+            TuningStats *into = &stats[t];
+            const TuningStats *from = &workers[i].stats[t];
+            into->matches += from->matches;
+            for (int k = 0; k < 3; ++k)
+                into->wins[k] += from->wins[k];
+            into->ticks += from->ticks;
+            for (int side = 0; side < 2; ++side)
+                for (int a = 0; a < ANIM_COUNT; ++a)
+                    into->damage[side][a] += from->damage[side][a];
+            into->sim_ns += from->sim_ns;
+            if (from->worst_tick_ns > into->worst_tick_ns)
+                into->worst_tick_ns = from->worst_tick_ns;
+        }
+
+    if (ok)
+    {
+        Uint64 ticks = 0;
+        for (int t = 0; t < job.tuning_count; ++t)
+            ticks += stats[t].ticks;
+        if (secs <= 0.0)
+            secs = 1e-9;
+        printf("Done in %.2f s: %.0f matches/s, %.0f ticks/s\n", secs, job.total / secs, ticks / secs);
+        print_results(stats, sweeps, sweep_count);
+        if (json_path && !write_json(json_path, stats))
+            ok = false;
+    }
+
+    for (int i = 0; i < started; ++i)
+        free(workers[i].stats);
+    fighter_assets_release();
+    asset_cache_clear();
+    asset_pack_close();
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,437 @@
+/* Microbenchmarks (make bench). Each benchmark runs a warm-up sample and
+ * then --samples timed samples of many operations; ns/op is reported per
+ * sample as mean, spread, min and median, and written as JSON so two
+ * builds can be compared (--compare OLD.json fails on a slower median).
+ *
+ * Simulation benchmarks run over a pool of mid-fight states captured from
+ * bot matches, each used once per sample, so every op sees a realistic
+ * state rather than the same one. Rendering and loading benchmarks need a
+ * window (a hidden one); without video they are skipped. Text is timed up
+ * to its sprite batch flush; presenting happens outside the timed loop. */
+#define SDL_MAIN_HANDLED
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sim.h"
+#include "background.h"
+#include "game_text.h"
+#include "asset_cache.h"
+#include "asset_pack.h"
+#include "texture_atlas.h"
+#include "sprite_batch.h"
+
+#define BENCH_DEFAULT_SAMPLES 20
+#define BENCH_MAX_SAMPLES 200
+#define BENCH_MAX_RESULTS 16
+#define BENCH_STATE_POOL 2048
+#define BENCH_FRAME_OPS 100
+#define BENCH_TEXT_OPS 500
+/* A slower median only counts as a regression beyond this, or beyond three
+ * times the run's own spread if that is larger */
+#define BENCH_REGRESSION 0.10
+
+#define BENCH_FONT "assets/texts/Pixelify_Sans/static/PixelifySans-Medium.ttf"
+#define BENCH_BACKGROUND "assets/textures/autumn.bmp"
+#define BENCH_HUD_STRING "delay 2  rb 40/96 ms  stalls 0"
+
+/* Packed alongside FIGHTER_TEXTURE_DIR, as the game does */
+static const char *const extra_fighter_sheets[] = {"assets/textures/jmph258w516.bmp"};
+
+typedef struct
+{
+    const char *name;
+    double mean, stddev, min, median; /* ns/op */
+    int samples;
+    int ops; /* per sample */
+} BenchResult;
+
+static BenchResult results[BENCH_MAX_RESULTS];
+static int result_count;
+static int sample_count = BENCH_DEFAULT_SAMPLES;
+static const char *filter;
+static double ticks_to_ns;
+
+/* Pristine captured states and the copy each sample works on */
+static SimState pool_src[BENCH_STATE_POOL];
+static SimState pool[BENCH_STATE_POOL];
+
+static bool bench_wanted(const char *name)
+{
+    return !filter || strstr(name, filter);
+}
+
+static int compare_double(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static void bench_report(const char *name, double *ns, int samples, int ops)
+{
+    if (result_count == BENCH_MAX_RESULTS)
+        return;
+    BenchResult *r = &results[result_count++];
+    r->name = name;
+    r->samples = samples;
+    r->ops = ops;
+
+    double sum = 0.0;
+    for (int i = 0; i < samples; ++i)
+        sum += ns[i];
+    r->mean = sum / samples;
+    double var = 0.0;
+    for (int i = 0; i < samples; ++i)
+        var += (ns[i] - r->mean) * (ns[i] - r->mean);
+    r->stddev = samples > 1 ? sqrt(var / (samples - 1)) : 0.0;
+
+    qsort(ns, (size_t)samples, sizeof(double), compare_double);
+    r->min = ns[0];
+    r->median = samples % 2 ? ns[samples / 2] : (ns[samples / 2 - 1] + ns[samples / 2]) / 2.0;
+
+    printf("%-22s %12.1f ns/op  +-%5.1f%%  min %12.1f  median %12.1f  (%d x %d)\n", name, r->mean,
+           r->mean > 0.0 ? 100.0 * r->stddev / r->mean : 0.0, r->min, r->median, samples, ops);
+}
+
+static double elapsed_ns(Uint64 start, int ops)
+{
+    return (double)(SDL_GetPerformanceCounter() - start) * ticks_to_ns / ops;
+}
+
+/* Closes in, then mixes attacks, blocks and jumps */
+static FighterInput bench_input(SimRng *rng, const FighterStore *f, int self, int other)
+{
+    static const FighterInput moves[] = {INPUT_ATTACK, INPUT_ATTACK, INPUT_DOWN_ATTACK, INPUT_BLOCK, INPUT_JUMP, 0};
+    float gap = f->x[other] - f->x[self];
+    if (gap > 120.0f || gap < -120.0f)
+        return gap > 0.0f ? INPUT_RIGHT : INPUT_LEFT;
+    return moves[sim_rng_range(rng, 0, (Uint32)(sizeof(moves) / sizeof(moves[0])) - 1)];
+}
+
+/* Plays bot matches back to back, keeping every other state still in a fight */
+static bool fill_pool(bool multiplayer)
+{
+    SimRng rng;
+    sim_rng_seed(&rng, 1);
+    Uint32 seed = 1;
+    SimState sim;
+    if (!sim_start(&sim, multiplayer, seed, SIM_STEP_MS))
+        return false;
+
+    for (int n = 0; n < BENCH_STATE_POOL;)
+    {
+        if (sim_fight_over(&sim))
+            sim_start(&sim, multiplayer, ++seed, SIM_STEP_MS);
+        FighterInput inputs[MAX_FIGHTERS] = {0};
+        inputs[sim.p1] = bench_input(&rng, &sim.fighters, sim.p1, sim.p2);
+        inputs[sim.p2] = bench_input(&rng, &sim.fighters, sim.p2, sim.p1);
+        sim_step(&sim, inputs);
+        if (sim.clock.tick % 2 == 0 && !sim_fight_over(&sim))
+            sim_save(&sim, &pool_src[n++]);
+    }
+    return true;
+}
+
+typedef enum
+{
+    SIM_OP_COMBAT, /* update_multi_fight */
+    SIM_OP_AI,     /* fighter_store_control with the AI opponent */
+    SIM_OP_STEP    /* sim_step */
+} SimOp;
+
+static void bench_sim(const char *name, bool multiplayer, SimOp op)
+{
+    if (!bench_wanted(name))
+        return;
+    if (!fill_pool(multiplayer))
+    {
+        fprintf(stderr, "%s: could not start a match\n", name);
+        return;
+    }
+
+    double ns[BENCH_MAX_SAMPLES];
+    FighterInput idle[MAX_FIGHTERS] = {0};
+    for (int s = -1; s < sample_count; ++s)
+    {
+        memcpy(pool, pool_src, sizeof(pool));
+        Uint64 start = SDL_GetPerformanceCounter();
+        switch (op)
+        {
+        case SIM_OP_COMBAT:
+            for (int i = 0; i < BENCH_STATE_POOL; ++i)
+            {
+                SimState *st = &pool[i];
+                game_clock_advance(&st->clock);
+                update_multi_fight(&st->multi, &st->fighters, st->p1, st->p2, &st->clock);
+            }
+            break;
+        case SIM_OP_AI:
+            for (int i = 0; i < BENCH_STATE_POOL; ++i)
+                fighter_store_control(&pool[i].fighters, idle, &pool[i].rng, pool[i].clock.now);
+            break;
+        case SIM_OP_STEP:
+            for (int i = 0; i < BENCH_STATE_POOL; ++i)
+                sim_step(&pool[i], idle);
+            break;
+        }
+        if (s >= 0)
+            ns[s] = elapsed_ns(start, BENCH_STATE_POOL);
+    }
+    bench_report(name, ns, sample_count, BENCH_STATE_POOL);
+}
+
+/* Cold: as at startup - the cache and atlas pages are emptied first, so
+ * every sheet is read, decoded, packed and uploaded. Warm: the sheets are
+ * still cached from the last match. */
+static void bench_fighter_load(const char *name, SDL_Renderer *ren, bool cold)
+{
+    if (!bench_wanted(name))
+        return;
+
+    double ns[BENCH_MAX_SAMPLES];
+    for (int s = -1; s < sample_count; ++s)
+    {
+        fighter_assets_release();
+        if (cold)
+        {
+            asset_cache_clear();
+            texture_atlas_destroy_all();
+        }
+        Uint64 start = SDL_GetPerformanceCounter();
+        if (cold)
+            texture_atlas_build_dir(ren, FIGHTER_TEXTURE_DIR, extra_fighter_sheets, 1);
+        bool ok = fighter_assets_acquire(ren);
+        double t = elapsed_ns(start, 1);
+        if (!ok)
+        {
+            fprintf(stderr, "%s: fighter sheets failed to load\n", name);
+            return;
+        }
+        if (s >= 0)
+            ns[s] = t;
+    }
+    bench_report(name, ns, sample_count, 1);
+}
+
+static void bench_background_frame(const char *name, SDL_Renderer *ren)
+{
+    if (!bench_wanted(name))
+        return;
+    Background *bg = create_background(ren, BENCH_BACKGROUND, 12, 100);
+    if (!bg)
+        return;
+
+    double ns[BENCH_MAX_SAMPLES];
+    for (int s = -1; s < sample_count; ++s)
+    {
+        Uint64 start = SDL_GetPerformanceCounter();
+        for (int i = 0; i < BENCH_FRAME_OPS; ++i)
+        {
+            SDL_RenderClear(ren);
+            render_background(ren, bg);
+            sprite_batch_end_frame();
+            SDL_RenderPresent(ren);
+        }
+        if (s >= 0)
+            ns[s] = elapsed_ns(start, BENCH_FRAME_OPS);
+    }
+    destroy_background(bg);
+    bench_report(name, ns, sample_count, BENCH_FRAME_OPS);
+}
+
+/* Laid out every call (text_draw) or once up front (text_draw_layout) */
+static void bench_text(const char *name, SDL_Renderer *ren, bool prepared)
+{
+    if (!bench_wanted(name))
+        return;
+    SDL_Color yellow = {255, 230, 0, 255};
+    TextLayout layout;
+    text_layout(&layout, BENCH_HUD_STRING, HUD_TEXT_SIZE);
+
+    double ns[BENCH_MAX_SAMPLES];
+    for (int s = -1; s < sample_count; ++s)
+    {
+        SDL_RenderClear(ren);
+        Uint64 start = SDL_GetPerformanceCounter();
+        for (int i = 0; i < BENCH_TEXT_OPS; ++i)
+        {
+            if (prepared)
+                text_draw_layout(ren, &layout, 1280 - 12, 46, yellow, TEXT_ALIGN_RIGHT);
+            else
+                text_draw(ren, BENCH_HUD_STRING, 1280 - 12, 46, HUD_TEXT_SIZE, yellow, TEXT_ALIGN_RIGHT);
+        }
+        sprite_batch_end_frame();
+        if (s >= 0)
+            ns[s] = elapsed_ns(start, BENCH_TEXT_OPS);
+        SDL_RenderPresent(ren);
+    }
+    bench_report(name, ns, sample_count, BENCH_TEXT_OPS);
+}
+
+static bool write_results(const char *path)
+{
+    FILE *f = fopen(path, "w");
+    if (!f)
+    {
+        fprintf(stderr, "Can't write %s\n", path);
+        return false;
+    }
+    /* One benchmark per line; --compare relies on it */
+    fprintf(f, "{\n  \"unit\": \"ns/op\",\n  \"benchmarks\": [\n");
+    for (int i = 0; i < result_count; ++i)
+    {
+        const BenchResult *r = &results[i];
+        fprintf(f,
+                "    {\"name\": \"%s\", \"mean\": %.3f, \"stddev\": %.3f, \"min\": %.3f, \"median\": %.3f, "
+                "\"samples\": %d, \"ops_per_sample\": %d}%s\n",
+                r->name, r->mean, r->stddev, r->min, r->median, r->samples, r->ops,
+                i + 1 < result_count ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+    fclose(f);
+    return true;
+}
+
+/* Returns the number of regressions against an earlier results file, -1 if
+ * it can't be read */
+static int compare_results(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    if (!f)
+    {
+        fprintf(stderr, "Can't read %s\n", path);
+        return -1;
+    }
+
+    printf("\nAgainst %s (medians):\n", path);
+    int regressions = 0;
+    char line[512];
+    while (fgets(line, sizeof(line), f))
+    {
+        char name[64];
+        double old_median;
+        const char *n = strstr(line, "\"name\": \"");
+        const char *m = strstr(line, "\"median\": ");
+        if (!n || !m || sscanf(n + 9, "%63[^\"]", name) != 1 || sscanf(m + 10, "%lf", &old_median) != 1)
+            continue;
+
+        for (int i = 0; i < result_count; ++i)
+        {
+            const BenchResult *r = &results[i];
+            if (strcmp(r->name, name) != 0 || old_median <= 0.0)
+                continue;
+            double change = r->median / old_median - 1.0;
+            double spread = r->mean > 0.0 ? 3.0 * r->stddev / r->mean : 0.0;
+            bool slower = change > (spread > BENCH_REGRESSION ? spread : BENCH_REGRESSION);
+            printf("%-22s %12.1f -> %12.1f  %+6.1f%%%s\n", name, old_median, r->median, 100.0 * change,
+                   slower ? "  REGRESSION" : "");
+            regressions += slower;
+        }
+    }
+    fclose(f);
+    return regressions;
+}
+
+static void print_usage(const char *prog)
+{
+    fprintf(stderr,
+            "Usage: %s [--out FILE] [--compare OLD.json] [--samples N] [--filter TEXT]\n"
+            "  --out      results as JSON (default build/bench.json)\n"
+            "  --compare  exit 1 if any median is slower than in OLD.json\n"
+            "  --filter   only benchmarks whose name contains TEXT\n",
+            prog);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *out_path = "build/bench.json";
+    const char *compare_path = NULL;
+    for (int i = 1; i < argc; ++i)
+    {
+        bool has_value = i + 1 < argc;
+        if (strcmp(argv[i], "--out") == 0 && has_value)
+            out_path = argv[++i];
+        else if (strcmp(argv[i], "--compare") == 0 && has_value)
+            compare_path = argv[++i];
+        else if (strcmp(argv[i], "--samples") == 0 && has_value)
+            sample_count = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--filter") == 0 && has_value)
+            filter = argv[++i];
+        else
+        {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+    if (sample_count < 2)
+        sample_count = 2;
+    if (sample_count > BENCH_MAX_SAMPLES)
+        sample_count = BENCH_MAX_SAMPLES;
+
+    SDL_SetMainReady();
+    if (SDL_Init(SDL_INIT_TIMER) != 0)
+    {
+        fprintf(stderr, "SDL_Init Error: %s\n", SDL_GetError());
+        return 1;
+    }
+    ticks_to_ns = 1e9 / (double)SDL_GetPerformanceFrequency();
+    asset_pack_open(ASSET_PACK_PATH);
+
+    /* Rendering needs a window; the simulation benchmarks run without one */
+    SDL_Window *win = NULL;
+    SDL_Renderer *ren = NULL;
+    if (SDL_InitSubSystem(SDL_INIT_VIDEO) == 0 && (IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG))
+    {
+        win = SDL_CreateWindow("SMACK! bench", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, 1280, 720,
+                               SDL_WINDOW_HIDDEN);
+        if (win)
+            ren = SDL_CreateRenderer(win, -1, SDL_RENDERER_ACCELERATED); /* no vsync */
+    }
+    if (!ren)
+        fprintf(stderr, "No renderer (%s): skipping rendering and loading benchmarks\n", SDL_GetError());
+
+    if (ren)
+        texture_atlas_build_dir(ren, FIGHTER_TEXTURE_DIR, extra_fighter_sheets, 1);
+    if (!fighter_assets_acquire(ren))
+    {
+        fprintf(stderr, "Fighter sheets failed to load\n");
+        return 1;
+    }
+
+    bench_sim("combat_tick", true, SIM_OP_COMBAT);
+    bench_sim("ai_decision", false, SIM_OP_AI);
+    bench_sim("sim_step_single", false, SIM_OP_STEP);
+    bench_sim("sim_step_multi", true, SIM_OP_STEP);
+
+    if (ren)
+    {
+        bench_fighter_load("fighter_load_cold", ren, true);
+        bench_fighter_load("fighter_load_warm", ren, false);
+        bench_background_frame("background_frame", ren);
+        if (text_init(BENCH_FONT, 48))
+        {
+            bench_text("text_draw", ren, false);
+            bench_text("text_draw_layout", ren, true);
+            text_quit();
+        }
+    }
+
+    bool ok = write_results(out_path);
+    if (ok)
+        printf("Results written to %s\n", out_path);
+    int regressions = compare_path ? compare_results(compare_path) : 0;
+
+    fighter_assets_release();
+    asset_cache_clear();
+    texture_atlas_destroy_all();
+    if (ren)
+        SDL_DestroyRenderer(ren);
+    if (win)
+        SDL_DestroyWindow(win);
+    asset_pack_close();
+    IMG_Quit();
+    SDL_Quit();
+    return ok && regressions == 0 ? 0 : 1;
+}
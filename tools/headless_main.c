@@ -0,0 +1,9 @@
+/* Entry point for the windowless build (make headless). Links only the
+ * simulation sources and core SDL2 - no video, audio, image or font libs. */
+#define SDL_MAIN_HANDLED
+#include "headless.h"
+
+int main(int argc, char *argv[])
+{
+    return headless_main(argc, argv);
+}